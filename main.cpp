@@ -1,3 +1,6 @@
+#ifdef _WIN32
+#define _CRT_RAND_S // rand_s(): the OS CSPRNG, used for salts and session tokens
+#endif
 #include <iostream>
 #include <string>
 #include <vector>
@@ -9,18 +12,685 @@
 #include <limits>
 #include <sstream>
 #include <iomanip>
+#include <thread>
+#include <charconv>
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <tuple>
+#include <iterator>
+#include <random>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#ifndef _WIN32
+#include <sys/random.h>
+#endif
+
+// Tracing zones. Build with -DSIP_PROFILE to enable them; otherwise SIP_ZONE expands to nothing.
+// A zone records its name, start and duration into a per-thread ring buffer while capture is
+// on. Capture is toggled with --trace PREFIX or SIGUSR1, and a trace exports as Chrome
+// trace-event JSON (PREFIX.json) plus folded stacks for flame graphs (PREFIX.folded).
+#ifdef SIP_PROFILE
+struct TraceEvent
+{
+    const char *name;
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t depth;
+};
 
-// Declare pause() before Warehouse class
-void pause()
+// Keeps the newest kCapacity events of one thread. Only the owning thread writes, so
+// record() is a few relaxed stores and one release store; an export reads concurrently
+// and drops any slot the owner may have rewritten while it was being copied.
+class TraceBuffer
+{
+    struct Slot
+    {
+        std::atomic<const char *> name;
+        std::atomic<uint64_t> startNs;
+        std::atomic<uint64_t> durationNs;
+        std::atomic<uint32_t> depth;
+    };
+    std::vector<Slot> slots;
+    std::atomic<uint64_t> written{0}; // events ever recorded; owning thread stores
+    std::atomic<uint64_t> floor{0};   // events before this were cleared; exporter stores
+
+public:
+    static const size_t kCapacity = 1 << 16;
+    const int threadIndex;
+    uint32_t depth = 0; // owning thread only
+    bool inUse = true;  // guarded by the profiler's registry mutex
+
+    explicit TraceBuffer(int threadIndex) : slots(kCapacity), threadIndex(threadIndex) {}
+
+    void record(const TraceEvent &event)
+    {
+        uint64_t index = written.load(std::memory_order_relaxed);
+        // Keeps the slot stores after the previous release, so a reader that sees them also sees index
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot &slot = slots[index % kCapacity];
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.startNs.store(event.startNs, std::memory_order_relaxed);
+        slot.durationNs.store(event.durationNs, std::memory_order_relaxed);
+        slot.depth.store(event.depth, std::memory_order_relaxed);
+        written.store(index + 1, std::memory_order_release);
+    }
+    std::vector<TraceEvent> snapshot() const
+    {
+        uint64_t end = written.load(std::memory_order_acquire);
+        uint64_t begin = std::min(end, std::max(end - std::min<uint64_t>(end, kCapacity), floor.load(std::memory_order_relaxed)));
+        std::vector<TraceEvent> out;
+        out.reserve(static_cast<size_t>(end - begin));
+        for (uint64_t i = begin; i < end; ++i)
+        {
+            const Slot &slot = slots[i % kCapacity];
+            out.push_back({slot.name.load(std::memory_order_relaxed), slot.startNs.load(std::memory_order_relaxed),
+                           slot.durationNs.load(std::memory_order_relaxed), slot.depth.load(std::memory_order_relaxed)});
+        }
+        // Event i shares its slot with event i + kCapacity. Every event up to `after` may have
+        // been written during the copy (`after` itself may be half written), so drop their slots.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = written.load(std::memory_order_relaxed);
+        if (after + 1 > begin + kCapacity)
+            out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min<uint64_t>(after + 1 - kCapacity - begin, out.size())));
+        return out;
+    }
+    // Hides everything recorded so far without touching the owner's write index
+    void clear() { floor.store(written.load(std::memory_order_acquire), std::memory_order_relaxed); }
+};
+
+class Profiler
+{
+    static std::mutex &registryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+    // Buffers outlive their threads so an export still sees work from finished threads.
+    // A finished thread's buffer goes to the next new thread, so the registry stays at the
+    // peak number of live threads instead of growing with every pool that comes and goes.
+    static std::vector<std::shared_ptr<TraceBuffer>> &registry()
+    {
+        static std::vector<std::shared_ptr<TraceBuffer>> buffers;
+        return buffers;
+    }
+    static std::vector<std::pair<int, std::vector<TraceEvent>>> collect()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        std::vector<std::pair<int, std::vector<TraceEvent>>> threads;
+        for (auto &buffer : registry())
+            threads.emplace_back(buffer->threadIndex, buffer->snapshot());
+        return threads;
+    }
+    static std::string escapeJson(const char *text)
+    {
+        std::string out;
+        for (; *text; ++text)
+        {
+            if (*text == '"' || *text == '\\')
+                out += '\\';
+            out += *text;
+        }
+        return out;
+    }
+
+public:
+    static std::atomic<bool> &capturing()
+    {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+    static uint64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static TraceBuffer &threadBuffer()
+    {
+        // Hands the buffer back to the registry when the thread exits
+        struct Lease
+        {
+            std::shared_ptr<TraceBuffer> buffer;
+            ~Lease()
+            {
+                std::lock_guard<std::mutex> lock(registryMutex());
+                buffer->inUse = false;
+            }
+        };
+        thread_local Lease lease{[]
+                                 {
+                                     std::lock_guard<std::mutex> lock(registryMutex());
+                                     for (auto &buffer : registry())
+                                         if (!buffer->inUse)
+                                         {
+                                             // Keeps its tid and old events; the threads never overlapped in time
+                                             buffer->inUse = true;
+                                             buffer->depth = 0;
+                                             return buffer;
+                                         }
+                                     registry().push_back(std::make_shared<TraceBuffer>(static_cast<int>(registry().size()) + 1));
+                                     return registry().back();
+                                 }()};
+        return *lease.buffer;
+    }
+
+    static void start()
+    {
+        {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for (auto &buffer : registry())
+                buffer->clear();
+        }
+        capturing() = true;
+    }
+    static void stop() { capturing() = false; }
+
+    static bool exportTrace(const std::string &prefix)
+    {
+        auto threads = collect();
+        uint64_t origin = std::numeric_limits<uint64_t>::max();
+        for (const auto &[tid, events] : threads)
+            for (const auto &event : events)
+                origin = std::min(origin, event.startNs);
+
+        std::ofstream json(prefix + ".json");
+        json << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto &[tid, events] : threads)
+            for (const auto &event : events)
+            {
+                json << (first ? "\n" : ",\n") << "{\"name\":\"" << escapeJson(event.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                     << std::fixed << std::setprecision(3) << ",\"ts\":" << (event.startNs - origin) / 1000.0
+                     << ",\"dur\":" << event.durationNs / 1000.0 << std::defaultfloat << '}';
+                first = false;
+            }
+        json << "\n]}\n";
+
+        // Folded stacks: rebuild each thread's call tree from start order and depth, then sum self time per stack
+        std::map<std::string, uint64_t> selfNs;
+        for (auto &[tid, events] : threads)
+        {
+            std::sort(events.begin(), events.end(), [](const TraceEvent &a, const TraceEvent &b)
+                      { return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth; });
+            std::vector<std::pair<std::string, const TraceEvent *>> stack; // path so far, frame
+            std::vector<uint64_t> childNs(events.size(), 0);
+            std::vector<std::string> paths(events.size());
+            std::vector<size_t> frameIndex;
+            for (size_t i = 0; i < events.size(); ++i)
+            {
+                const TraceEvent &event = events[i];
+                // Frames that ended before this event started, or sit at its depth or deeper, are done
+                while (!frameIndex.empty() && (events[frameIndex.back()].depth >= event.depth ||
+                                               events[frameIndex.back()].startNs + events[frameIndex.back()].durationNs <= event.startNs))
+                    frameIndex.pop_back();
+                if (!frameIndex.empty())
+                {
+                    childNs[frameIndex.back()] += event.durationNs;
+                    paths[i] = paths[frameIndex.back()] + ';';
+                }
+                paths[i] += event.name;
+                frameIndex.push_back(i);
+            }
+            for (size_t i = 0; i < events.size(); ++i)
+                selfNs[paths[i]] += events[i].durationNs - std::min(childNs[i], events[i].durationNs);
+        }
+        std::ofstream folded(prefix + ".folded");
+        for (const auto &[path, ns] : selfNs)
+            folded << path << ' ' << ns << '\n';
+        return static_cast<bool>(json) && static_cast<bool>(folded);
+    }
+
+    // Each SIGUSR1 toggles capture; turning it off writes PREFIX.json and PREFIX.folded.
+    // The handler only bumps a counter; a watcher thread does the work.
+    static void installSignalTrigger(const std::string &prefix)
+    {
+#ifdef SIGUSR1
+        static std::atomic<int> requests{0};
+        std::signal(SIGUSR1, [](int)
+                    { requests.fetch_add(1, std::memory_order_relaxed); });
+        std::thread([prefix]
+                    {
+            int handled = 0;
+            while (true)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                int pending = requests.load(std::memory_order_relaxed);
+                for (; handled < pending; ++handled)
+                {
+                    if (!capturing())
+                    {
+                        start();
+                        continue;
+                    }
+                    stop();
+                    exportTrace(prefix);
+                }
+            } })
+            .detach();
+#else
+        (void)prefix;
+#endif
+    }
+};
+
+class ProfileZone
+{
+    const char *name;
+    uint64_t startNs = 0;
+    bool active;
+
+public:
+    explicit ProfileZone(const char *name) : name(name), active(Profiler::capturing().load(std::memory_order_relaxed))
+    {
+        if (active)
+        {
+            ++Profiler::threadBuffer().depth;
+            startNs = Profiler::nowNs();
+        }
+    }
+    ~ProfileZone()
+    {
+        if (!active)
+            return;
+        uint64_t endNs = Profiler::nowNs();
+        TraceBuffer &buffer = Profiler::threadBuffer();
+        --buffer.depth;
+        buffer.record({name, startNs, endNs - startNs, buffer.depth});
+    }
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+};
+
+// Writes the trace when it goes out of scope, if capture is still on
+class TraceOnExit
+{
+    std::string prefix;
+
+public:
+    explicit TraceOnExit(const std::string &prefix) : prefix(prefix) {}
+    ~TraceOnExit()
+    {
+        if (Profiler::capturing())
+        {
+            Profiler::stop();
+            if (Profiler::exportTrace(prefix))
+                std::cout << "Trace written to " << prefix << ".json and " << prefix << ".folded\n";
+        }
+    }
+};
+
+#define SIP_ZONE_CONCAT2(a, b) a##b
+#define SIP_ZONE_CONCAT(a, b) SIP_ZONE_CONCAT2(a, b)
+#define SIP_ZONE(name) ProfileZone SIP_ZONE_CONCAT(sipZone, __LINE__)(name)
+#else
+#define SIP_ZONE(name) ((void)0)
+#endif
+
+// Declare pauseScreen() before Warehouse class
+void pauseScreen()
 {
     std::cout << "Press Enter to continue...";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     std::cin.get();
 }
 
+// Password hashing: scrypt (RFC 7914) over SHA-256, with a random salt per password.
+// Stored form: $scrypt$<log2 N>$<r>$<p>$<salt hex>$<hash hex>
+class Sha256
+{
+    uint32_t state[8];
+    unsigned char buffer[64];
+    uint64_t length = 0;
+    size_t used = 0;
+
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void compress(const unsigned char *block)
+    {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i)
+            w[i] = uint32_t(block[4 * i]) << 24 | uint32_t(block[4 * i + 1]) << 16 | uint32_t(block[4 * i + 2]) << 8 | block[4 * i + 3];
+        for (int i = 16; i < 64; ++i)
+        {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i)
+        {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+public:
+    Sha256() : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19} {}
+
+    void update(const unsigned char *data, size_t size)
+    {
+        length += size;
+        while (size > 0)
+        {
+            size_t take = std::min(size, sizeof(buffer) - used);
+            std::memcpy(buffer + used, data, take);
+            used += take;
+            data += take;
+            size -= take;
+            if (used == sizeof(buffer))
+            {
+                compress(buffer);
+                used = 0;
+            }
+        }
+    }
+    void finish(unsigned char out[32])
+    {
+        uint64_t bits = length * 8;
+        unsigned char pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (used != 56)
+            update(&pad, 1);
+        for (int i = 7; i >= 0; --i)
+            buffer[56 + (7 - i)] = static_cast<unsigned char>(bits >> (8 * i));
+        compress(buffer);
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 4; ++j)
+                out[4 * i + j] = static_cast<unsigned char>(state[i] >> (24 - 8 * j));
+    }
+};
+
+// PBKDF2-HMAC-SHA256 with a single iteration, which is all scrypt needs
+std::vector<unsigned char> pbkdf2Sha256(const std::string &password, const unsigned char *salt, size_t saltSize, size_t outSize)
+{
+    unsigned char key[64] = {};
+    if (password.size() > 64)
+    {
+        Sha256 h;
+        h.update(reinterpret_cast<const unsigned char *>(password.data()), password.size());
+        h.finish(key);
+    }
+    else
+    {
+        std::memcpy(key, password.data(), password.size());
+    }
+    unsigned char ipad[64], opad[64];
+    for (int i = 0; i < 64; ++i)
+    {
+        ipad[i] = key[i] ^ 0x36;
+        opad[i] = key[i] ^ 0x5c;
+    }
+    std::vector<unsigned char> out(outSize);
+    for (uint32_t block = 1, offset = 0; offset < outSize; ++block, offset += 32)
+    {
+        unsigned char counter[4] = {static_cast<unsigned char>(block >> 24), static_cast<unsigned char>(block >> 16),
+                                    static_cast<unsigned char>(block >> 8), static_cast<unsigned char>(block)};
+        unsigned char inner[32], digest[32];
+        Sha256 hi;
+        hi.update(ipad, 64);
+        hi.update(salt, saltSize);
+        hi.update(counter, 4);
+        hi.finish(inner);
+        Sha256 ho;
+        ho.update(opad, 64);
+        ho.update(inner, 32);
+        ho.finish(digest);
+        std::memcpy(out.data() + offset, digest, std::min<size_t>(32, outSize - offset));
+    }
+    return out;
+}
+
+void salsa20_8(uint32_t b[16])
+{
+    auto rotl = [](uint32_t x, int n)
+    { return (x << n) | (x >> (32 - n)); };
+    uint32_t x[16];
+    std::memcpy(x, b, sizeof(x));
+    for (int i = 0; i < 8; i += 2)
+    {
+        x[4] ^= rotl(x[0] + x[12], 7), x[8] ^= rotl(x[4] + x[0], 9), x[12] ^= rotl(x[8] + x[4], 13), x[0] ^= rotl(x[12] + x[8], 18);
+        x[9] ^= rotl(x[5] + x[1], 7), x[13] ^= rotl(x[9] + x[5], 9), x[1] ^= rotl(x[13] + x[9], 13), x[5] ^= rotl(x[1] + x[13], 18);
+        x[14] ^= rotl(x[10] + x[6], 7), x[2] ^= rotl(x[14] + x[10], 9), x[6] ^= rotl(x[2] + x[14], 13), x[10] ^= rotl(x[6] + x[2], 18);
+        x[3] ^= rotl(x[15] + x[11], 7), x[7] ^= rotl(x[3] + x[15], 9), x[11] ^= rotl(x[7] + x[3], 13), x[15] ^= rotl(x[11] + x[7], 18);
+        x[1] ^= rotl(x[0] + x[3], 7), x[2] ^= rotl(x[1] + x[0], 9), x[3] ^= rotl(x[2] + x[1], 13), x[0] ^= rotl(x[3] + x[2], 18);
+        x[6] ^= rotl(x[5] + x[4], 7), x[7] ^= rotl(x[6] + x[5], 9), x[4] ^= rotl(x[7] + x[6], 13), x[5] ^= rotl(x[4] + x[7], 18);
+        x[11] ^= rotl(x[10] + x[9], 7), x[8] ^= rotl(x[11] + x[10], 9), x[9] ^= rotl(x[8] + x[11], 13), x[10] ^= rotl(x[9] + x[8], 18);
+        x[12] ^= rotl(x[15] + x[14], 7), x[13] ^= rotl(x[12] + x[15], 9), x[14] ^= rotl(x[13] + x[12], 13), x[15] ^= rotl(x[14] + x[13], 18);
+    }
+    for (int i = 0; i < 16; ++i)
+        b[i] += x[i];
+}
+
+// scrypt BlockMix: 'b' holds 2r 64-byte blocks, 'y' is scratch of the same size
+void scryptBlockMix(uint32_t *b, uint32_t *y, size_t r)
+{
+    uint32_t x[16];
+    std::memcpy(x, &b[(2 * r - 1) * 16], 64);
+    for (size_t i = 0; i < 2 * r; ++i)
+    {
+        for (int j = 0; j < 16; ++j)
+            x[j] ^= b[i * 16 + j];
+        salsa20_8(x);
+        // Even blocks go to the first half of the output, odd blocks to the second
+        std::memcpy(&y[((i / 2) + (i % 2) * r) * 16], x, 64);
+    }
+    std::memcpy(b, y, 128 * r);
+}
+
+std::vector<unsigned char> scrypt(const std::string &password, const unsigned char *salt, size_t saltSize,
+                                  int logN, size_t r, size_t p, size_t outSize)
+{
+    const size_t n = size_t(1) << logN;
+    const size_t words = 32 * r;
+    std::vector<unsigned char> b = pbkdf2Sha256(password, salt, saltSize, p * 128 * r);
+    std::vector<uint32_t> x(words), y(words), v(words * n);
+    for (size_t block = 0; block < p; ++block)
+    {
+        unsigned char *bi = b.data() + block * 128 * r;
+        for (size_t k = 0; k < words; ++k)
+            x[k] = uint32_t(bi[4 * k]) | uint32_t(bi[4 * k + 1]) << 8 | uint32_t(bi[4 * k + 2]) << 16 | uint32_t(bi[4 * k + 3]) << 24;
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::memcpy(&v[i * words], x.data(), words * 4);
+            scryptBlockMix(x.data(), y.data(), r);
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t j = x[(2 * r - 1) * 16] & (n - 1);
+            for (size_t k = 0; k < words; ++k)
+                x[k] ^= v[j * words + k];
+            scryptBlockMix(x.data(), y.data(), r);
+        }
+        for (size_t k = 0; k < words; ++k)
+            for (int byte = 0; byte < 4; ++byte)
+                bi[4 * k + byte] = static_cast<unsigned char>(x[k] >> (8 * byte));
+    }
+    return pbkdf2Sha256(password, b.data(), b.size(), outSize);
+}
+
+std::string toHex(const unsigned char *data, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(size * 2);
+    for (size_t i = 0; i < size; ++i)
+    {
+        out += digits[data[i] >> 4];
+        out += digits[data[i] & 15];
+    }
+    return out;
+}
+
+bool fromHex(const std::string &hex, std::vector<unsigned char> &out)
+{
+    if (hex.size() % 2 != 0)
+        return false;
+    out.resize(hex.size() / 2);
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        unsigned value;
+        auto result = std::from_chars(hex.data() + 2 * i, hex.data() + 2 * i + 2, value, 16);
+        if (result.ec != std::errc() || result.ptr != hex.data() + 2 * i + 2)
+            return false;
+        out[i] = static_cast<unsigned char>(value);
+    }
+    return true;
+}
+
+// Salts and session tokens come straight from the OS CSPRNG. std::random_device is not
+// used because it may be deterministic (older MinGW). Failure aborts rather than weakening them.
+std::vector<unsigned char> randomBytes(size_t count)
+{
+    std::vector<unsigned char> out(count);
+#ifdef _WIN32
+    for (size_t i = 0; i < count; i += sizeof(unsigned int))
+    {
+        unsigned int value;
+        if (rand_s(&value) != 0)
+        {
+            std::cerr << "rand_s failed; refusing to continue without secure randomness.\n";
+            std::abort();
+        }
+        std::memcpy(out.data() + i, &value, std::min(sizeof(value), count - i));
+    }
+#else
+    for (size_t i = 0; i < count; i += 256) // getentropy serves at most 256 bytes per call
+    {
+        if (getentropy(out.data() + i, std::min<size_t>(256, count - i)) != 0)
+        {
+            std::cerr << "getentropy failed; refusing to continue without secure randomness.\n";
+            std::abort();
+        }
+    }
+#endif
+    return out;
+}
+
+// Cost parameters for new hashes: N = 2^14, r = 8 uses 16 MiB per verification
+const int kScryptLogN = 14;
+const int kScryptR = 8;
+const int kScryptP = 1;
+
+std::string hashPassword(const std::string &password)
+{
+    std::vector<unsigned char> salt = randomBytes(16);
+    std::vector<unsigned char> hash = scrypt(password, salt.data(), salt.size(), kScryptLogN, kScryptR, kScryptP, 32);
+    return "$scrypt$" + std::to_string(kScryptLogN) + '$' + std::to_string(kScryptR) + '$' + std::to_string(kScryptP) + '$' +
+           toHex(salt.data(), salt.size()) + '$' + toHex(hash.data(), hash.size());
+}
+
+// Parameters are read from the stored hash, so older cost settings keep verifying
+bool verifyPassword(const std::string &password, const std::string &stored)
+{
+    const std::string prefix = "$scrypt$";
+    if (stored.compare(0, prefix.size(), prefix) != 0)
+        return false;
+    std::vector<std::string> parts;
+    std::istringstream iss(stored.substr(prefix.size()));
+    std::string part;
+    while (std::getline(iss, part, '$'))
+        parts.push_back(part);
+    std::vector<unsigned char> salt, expected;
+    int logN, r, p;
+    if (parts.size() != 5 || !fromHex(parts[3], salt) || !fromHex(parts[4], expected) || expected.empty())
+        return false;
+    try
+    {
+        logN = std::stoi(parts[0]);
+        r = std::stoi(parts[1]);
+        p = std::stoi(parts[2]);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    if (logN < 1 || logN > 20 || r < 1 || r > 32 || p < 1 || p > 16)
+        return false;
+    std::vector<unsigned char> actual = scrypt(password, salt.data(), salt.size(), logN, r, p, expected.size());
+    unsigned char diff = 0; // constant-time compare
+    for (size_t i = 0; i < expected.size(); ++i)
+        diff |= actual[i] ^ expected[i];
+    return diff == 0;
+}
+
+// Known-answer checks for the hashing code above (SHA-256 FIPS 180-2 "abc", RFC 7914
+// sections 11 and 12). A regression here would lock every member out, so --self-test and
+// --bench-auth run these first.
+bool selfTestCrypto()
+{
+    auto check = [](const char *label, const std::vector<unsigned char> &actual, const char *expected)
+    {
+        bool ok = toHex(actual.data(), actual.size()) == expected;
+        std::cout << (ok ? "  ok      " : "  FAILED  ") << label << "\n";
+        return ok;
+    };
+    const unsigned char abc[] = {'a', 'b', 'c'};
+    std::vector<unsigned char> sha(32);
+    Sha256 hasher;
+    hasher.update(abc, sizeof(abc));
+    hasher.finish(sha.data());
+    const unsigned char salt[] = {'s', 'a', 'l', 't'};
+    const unsigned char nacl[] = {'N', 'a', 'C', 'l'};
+
+    bool ok = check("SHA-256(\"abc\")", sha, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    ok &= check("PBKDF2-HMAC-SHA256(\"passwd\", \"salt\", 1, 64)", pbkdf2Sha256("passwd", salt, sizeof(salt), 64),
+                "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783");
+    ok &= check("scrypt(\"\", \"\", N=16, r=1, p=1)", scrypt("", nullptr, 0, 4, 1, 1, 64),
+                "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442"
+                "fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+    ok &= check("scrypt(\"password\", \"NaCl\", N=1024, r=8, p=16)", scrypt("password", nacl, sizeof(nacl), 10, 8, 16, 64),
+                "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b373162"
+                "2eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640");
+    std::string stored = hashPassword("correct horse");
+    bool roundTrip = verifyPassword("correct horse", stored) && !verifyPassword("correct horsf", stored);
+    std::cout << (roundTrip ? "  ok      " : "  FAILED  ") << "hashPassword/verifyPassword round trip\n";
+    return ok && roundTrip;
+}
+
+// Compile-time record schemas, specialized for each entity further down
+template <typename T>
+struct Schema;
+
 // Product class
 class Product
 {
+    template <typename T>
+    friend struct Schema;
+
     int id;
     std::string name;
     int stock;
@@ -48,6 +718,9 @@ public:
 // Supplier class
 class Supplier
 {
+    template <typename T>
+    friend struct Schema;
+
     int id;
     std::string name;
     std::string contact;
@@ -68,25 +741,30 @@ public:
 // Member class (for employees/customers)
 class Member
 {
+    template <typename T>
+    friend struct Schema;
+
     int id;
     std::string name;
     std::string role;
-    std::string password;
+    std::string passwordHash; // see hashPassword()
 
 public:
-    Member() : id(0), name(""), role(""), password("") {} // Default constructor
+    Member() : id(0), name(""), role(""), passwordHash("") {} // Default constructor
     Member(int id, const std::string &name, const std::string &role, const std::string &password)
-        : id(id), name(name), role(role), password(password) {}
+        : id(id), name(name), role(role), passwordHash(hashPassword(password)) {}
 
     int getId() const { return id; }
     std::string getName() const { return name; }
     std::string getRole() const { return role; }
-    bool authenticate(const std::string &pwd) const { return pwd == password; }
-    std::string getPassword() const { return password; }
+    bool authenticate(const std::string &pwd) const { return verifyPassword(pwd, passwordHash); }
+    const std::string &getPasswordHash() const { return passwordHash; }
 
     void setName(const std::string &newName) { name = newName; }
     void setRole(const std::string &newRole) { role = newRole; }
-    void setPassword(const std::string &newPassword) { password = newPassword; }
+    void setPassword(const std::string &newPassword) { passwordHash = hashPassword(newPassword); }
+    // Members read from a version 1 members.txt still hold their plaintext password here
+    void hashLegacyPassword() { passwordHash = hashPassword(passwordHash); }
 };
 
 // OrderItem class
@@ -122,6 +800,273 @@ public:
     std::chrono::system_clock::time_point getDate() const { return date; }
 };
 
+// The rule every order path shares (tryProcessOrder, processOrders, holds): each line must
+// ask for a positive quantity, and lines for the same product are checked as one total.
+// Fills 'quantities' (productId -> total); false with 'reason' set on a bad line.
+bool combineOrderLines(const Order &order, std::map<int, int> &quantities, std::string *reason)
+{
+    quantities.clear();
+    for (const auto &item : order.getItems())
+    {
+        if (item.getQuantity() <= 0)
+        {
+            if (reason)
+                *reason = "Invalid quantity " + std::to_string(item.getQuantity()) + " for product ID " +
+                          std::to_string(item.getProductId()) + ".";
+            return false;
+        }
+        quantities[item.getProductId()] += item.getQuantity();
+    }
+    return true;
+}
+
+// StockDelta struct (signed stock adjustment used by the bulk APIs)
+struct StockDelta
+{
+    int productId;
+    int amount;
+};
+
+// Field parsers: read one field starting at 'p', then step past its delimiter
+bool parseIntField(const char *&p, const char *end, char delim, int &out)
+{
+    auto result = std::from_chars(p, end, out);
+    if (result.ec != std::errc() || (result.ptr != end && *result.ptr != delim))
+        return false;
+    p = result.ptr == end ? end : result.ptr + 1;
+    return true;
+}
+
+bool parseDoubleField(const char *&p, const char *end, char delim, double &out)
+{
+    auto result = std::from_chars(p, end, out);
+    if (result.ec != std::errc() || (result.ptr != end && *result.ptr != delim))
+        return false;
+    p = result.ptr == end ? end : result.ptr + 1;
+    return true;
+}
+
+bool parseStringField(const char *&p, const char *end, char delim, std::string &out)
+{
+    const char *stop = static_cast<const char *>(std::memchr(p, delim, end - p));
+    if (!stop)
+        stop = end;
+    out.assign(p, stop);
+    p = stop == end ? end : stop + 1;
+    return true;
+}
+
+// Field encoders for each supported member type.
+// The binary layout is host-endian: ints are 4 bytes, doubles 8, strings a 4-byte length plus bytes.
+void writeFieldText(std::ostream &out, int value) { out << value; }
+void writeFieldText(std::ostream &out, double value) { out << value; }
+void writeFieldText(std::ostream &out, const std::string &value) { out << value; }
+
+bool readFieldText(const char *&p, const char *end, char delim, int &value) { return parseIntField(p, end, delim, value); }
+bool readFieldText(const char *&p, const char *end, char delim, double &value) { return parseDoubleField(p, end, delim, value); }
+bool readFieldText(const char *&p, const char *end, char delim, std::string &value) { return parseStringField(p, end, delim, value); }
+
+template <typename V>
+void writeFieldBinary(std::string &out, const V &value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(V));
+}
+void writeFieldBinary(std::string &out, const std::string &value)
+{
+    writeFieldBinary(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+template <typename V>
+bool readFieldBinary(const char *&p, const char *end, V &value)
+{
+    if (static_cast<size_t>(end - p) < sizeof(V))
+        return false;
+    std::memcpy(&value, p, sizeof(V));
+    p += sizeof(V);
+    return true;
+}
+bool readFieldBinary(const char *&p, const char *end, std::string &value)
+{
+    uint32_t size;
+    if (!readFieldBinary(p, end, size) || static_cast<size_t>(end - p) < size)
+        return false;
+    value.assign(p, size);
+    p += size;
+    return true;
+}
+
+// One persisted field: its name, the member it maps to and the schema version that added it
+template <typename T, typename M>
+struct Field
+{
+    const char *name;
+    M T::*member;
+    int since;
+    const char *description; // used in per-row error messages
+    bool required;           // imported rows must not leave it empty
+
+    constexpr Field describedAs(const char *text) const { return {name, member, since, text, required}; }
+    constexpr Field nonEmpty() const { return {name, member, since, description, true}; }
+};
+
+template <typename T, typename M>
+constexpr Field<T, M> field(const char *name, M T::*member, int since = 1)
+{
+    return {name, member, since, name, false};
+}
+
+bool isEmptyField(const std::string &value) { return value.empty(); }
+template <typename V>
+bool isEmptyField(const V &) { return false; }
+
+// The store files are TSV, so a tab or carriage return inside a string cannot be written back
+bool breaksTsvField(const std::string &value) { return value.find_first_of("\t\r") != std::string::npos; }
+template <typename V>
+bool breaksTsvField(const V &) { return false; }
+
+// TSV and binary reader/writer generated from Schema<T>::fields().
+// Adding a field is one line in the Schema (bump its version and pass it as 'since');
+// records written by an older version leave the newer fields at their defaults.
+template <typename T>
+struct RecordCodec
+{
+    static constexpr auto fields = Schema<T>::fields();
+    static constexpr int version = Schema<T>::version;
+
+    // "#schema<TAB>name<TAB>version", written as the first line of a TSV file
+    static std::string header()
+    {
+        return std::string("#schema\t") + Schema<T>::name + '\t' + std::to_string(version);
+    }
+    // Accepts headers for this entity up to the current version
+    static bool readHeader(const std::string &line, int &fileVersion)
+    {
+        std::string expected = std::string("#schema\t") + Schema<T>::name + '\t';
+        if (line.compare(0, expected.size(), expected) != 0)
+            return false;
+        const char *p = line.data() + expected.size();
+        const char *end = line.data() + line.size();
+        if (p != end && end[-1] == '\r')
+            --end;
+        return parseIntField(p, end, '\t', fileVersion) && p == end && fileVersion >= 1 && fileVersion <= version;
+    }
+
+    static void writeText(std::ostream &out, const T &record, char delim = '\t')
+    {
+        bool first = true;
+        std::apply([&](const auto &...f)
+                   { ((first ? void() : void(out << delim), writeFieldText(out, record.*(f.member)), first = false), ...); },
+                   fields);
+        out << '\n';
+    }
+    // With 'validate' (used for imported rows), required fields must be non-empty and
+    // strings must not contain characters the TSV store cannot hold
+    static bool readText(const char *p, const char *end, char delim, T &record, std::string &error, int fileVersion,
+                         bool validate = false)
+    {
+        bool ok = true;
+        auto readOne = [&](const auto &f)
+        {
+            if (f.since > fileVersion)
+                return true;
+            if (!readFieldText(p, end, delim, record.*(f.member)))
+                error = std::string("invalid ") + f.description;
+            else if (validate && f.required && isEmptyField(record.*(f.member)))
+                error = std::string("missing ") + f.description;
+            else if (validate && breaksTsvField(record.*(f.member)))
+                error = std::string(f.description) + " contains a tab or carriage return";
+            else
+                return true;
+            return false;
+        };
+        std::apply([&](const auto &...f)
+                   { ((ok = ok && readOne(f)), ...); },
+                   fields);
+        if (ok && p != end)
+        {
+            error = "too many fields";
+            ok = false;
+        }
+        return ok;
+    }
+    // Current-version, validating row parser in the shape parseChunked expects
+    static bool readRow(const char *p, const char *end, char delim, T &record, std::string &error)
+    {
+        return readText(p, end, delim, record, error, version, true);
+    }
+
+    static void writeBinary(std::string &out, const T &record)
+    {
+        std::apply([&](const auto &...f)
+                   { (writeFieldBinary(out, record.*(f.member)), ...); },
+                   fields);
+    }
+    static bool readBinary(const char *&p, const char *end, T &record, int fileVersion)
+    {
+        bool ok = true;
+        std::apply([&](const auto &...f)
+                   { ((ok = ok && (f.since > fileVersion || readFieldBinary(p, end, record.*(f.member)))), ...); },
+                   fields);
+        return ok;
+    }
+};
+
+template <>
+struct Schema<Product>
+{
+    static constexpr const char *name = "products";
+    static constexpr int version = 1;
+    static constexpr auto fields()
+    {
+        return std::make_tuple(field("id", &Product::id).describedAs("product ID"),
+                               field("name", &Product::name).nonEmpty(),
+                               field("stock", &Product::stock),
+                               field("price", &Product::price),
+                               field("supplierId", &Product::supplierId).describedAs("supplier ID"));
+    }
+};
+
+template <>
+struct Schema<Supplier>
+{
+    static constexpr const char *name = "suppliers";
+    static constexpr int version = 1;
+    static constexpr auto fields()
+    {
+        return std::make_tuple(field("id", &Supplier::id),
+                               field("name", &Supplier::name),
+                               field("contact", &Supplier::contact));
+    }
+};
+
+// Version 2: the last column holds a salted scrypt hash instead of the plaintext password
+template <>
+struct Schema<Member>
+{
+    static constexpr const char *name = "members";
+    static constexpr int version = 2;
+    static constexpr auto fields()
+    {
+        return std::make_tuple(field("id", &Member::id),
+                               field("name", &Member::name),
+                               field("role", &Member::role),
+                               field("passwordHash", &Member::passwordHash));
+    }
+};
+
+template <>
+struct Schema<StockDelta>
+{
+    static constexpr const char *name = "stock_deltas";
+    static constexpr int version = 1;
+    static constexpr auto fields()
+    {
+        return std::make_tuple(field("productId", &StockDelta::productId).describedAs("product ID"),
+                               field("amount", &StockDelta::amount).describedAs("stock delta"));
+    }
+};
+
 // Inventory class
 class Inventory
 {
@@ -134,10 +1079,55 @@ public:
     }
     void updateStock(int productId, int amount)
     {
-        if (products.find(productId) != products.end())
+        auto it = products.find(productId);
+        if (it != products.end())
+        {
+            it->second.updateStock(amount);
+        }
+    }
+    // Bulk insert; like addProduct, existing IDs are overwritten
+    void addProducts(const std::vector<Product> &batch)
+    {
+        SIP_ZONE("Inventory::addProducts");
+        // Insert in ID order so each insert can use the previous position as a hint
+        std::vector<size_t> order(batch.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&batch](size_t a, size_t b)
+                         { return batch[a].getId() < batch[b].getId(); });
+        auto hint = products.begin();
+        for (size_t i : order)
+        {
+            const Product &product = batch[i];
+            hint = std::next(products.insert_or_assign(hint, product.getId(), product));
+        }
+    }
+    // Apply many stock adjustments in one pass.
+    // Returns the indices of deltas whose product was not found (those are skipped).
+    std::vector<size_t> applyBatch(const std::vector<StockDelta> &deltas)
+    {
+        SIP_ZONE("Inventory::applyBatch");
+        // Visit products in ID order: neighbouring lookups then touch neighbouring tree nodes
+        std::vector<size_t> order(deltas.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&deltas](size_t a, size_t b)
+                         { return deltas[a].productId < deltas[b].productId; });
+        std::vector<size_t> rejected;
+        auto it = products.end();
+        for (size_t i : order)
         {
-            products[productId].updateStock(amount);
+            if (it == products.end() || it->first != deltas[i].productId)
+                it = products.find(deltas[i].productId);
+            if (it == products.end())
+            {
+                rejected.push_back(i);
+                continue;
+            }
+            it->second.updateStock(deltas[i].amount);
         }
+        std::sort(rejected.begin(), rejected.end());
+        return rejected;
     }
     Product *getProduct(int productId)
     {
@@ -148,6 +1138,7 @@ public:
     }
     std::vector<Product> getLowStockProducts(int threshold)
     {
+        SIP_ZONE("Inventory::getLowStockProducts");
         std::vector<Product> lowStock;
         for (auto &[id, product] : products)
         {
@@ -167,6 +1158,467 @@ public:
     }
 };
 
+// Hierarchical timing wheel with one-second ticks: 4 levels of 256 slots.
+// Scheduling is O(1); an entry is moved down at most once per level before it fires,
+// so expiring it is O(1) amortized no matter how many entries are outstanding.
+class TimingWheel
+{
+    struct Entry
+    {
+        uint64_t id;
+        uint64_t expiresAt;
+    };
+    static const int kLevels = 4;
+    static const int kSlotBits = 8;
+    static const uint64_t kSlotMask = (1 << kSlotBits) - 1;
+
+    std::vector<Entry> slots[kLevels][1 << kSlotBits];
+    uint64_t current = 0; // last processed tick
+    size_t pending = 0;
+
+    // Lowest level whose current rotation still reaches 'expiresAt'
+    void place(const Entry &entry)
+    {
+        int level = 0;
+        while (level < kLevels - 1 && (entry.expiresAt >> (kSlotBits * (level + 1))) != (current >> (kSlotBits * (level + 1))))
+            ++level;
+        slots[level][(entry.expiresAt >> (kSlotBits * level)) & kSlotMask].push_back(entry);
+    }
+
+public:
+    uint64_t now() const { return current; }
+    size_t size() const { return pending; }
+
+    // Entries due at or before the current tick fire on the next one
+    void schedule(uint64_t id, uint64_t expiresAt)
+    {
+        place({id, std::max(expiresAt, current + 1)});
+        ++pending;
+    }
+
+    // Process ticks up to 'to', calling fire(id) for each expired entry
+    template <typename Fire>
+    void advance(uint64_t to, Fire fire)
+    {
+        if (pending == 0)
+        {
+            current = std::max(current, to);
+            return;
+        }
+        while (current < to)
+        {
+            ++current;
+            // Cascade higher levels whose rotation starts at this tick, top-down
+            for (int level = kLevels - 1; level > 0; --level)
+            {
+                if ((current & ((uint64_t(1) << (kSlotBits * level)) - 1)) != 0)
+                    continue;
+                std::vector<Entry> moving;
+                moving.swap(slots[level][(current >> (kSlotBits * level)) & kSlotMask]);
+                for (const Entry &entry : moving)
+                    place(entry);
+            }
+            std::vector<Entry> due;
+            due.swap(slots[0][current & kSlotMask]);
+            for (const Entry &entry : due)
+            {
+                if (entry.expiresAt > current) // beyond the top level's horizon; wait another rotation
+                {
+                    place(entry);
+                    continue;
+                }
+                --pending;
+                fire(entry.id);
+            }
+            if (pending == 0)
+            {
+                current = std::max(current, to);
+                return;
+            }
+        }
+    }
+};
+
+// Soft holds on stock: a hold reserves an order's quantities until it is confirmed,
+// released, or its time runs out. Holds are cancelled lazily, so the wheel may still
+// carry IDs that are no longer in 'holds'; hold IDs are never reused.
+// Holds only gate orders and other holds. Direct stock corrections (applyBatch, an import
+// overwrite, Edit Product) record what is physically there and may drop stock below the
+// held amount, so confirm re-checks stock and fails if the goods are no longer there.
+class ReservationBook
+{
+    struct Hold
+    {
+        Order order;
+        std::map<int, int> quantities; // productId -> total held, lines for the same product combined
+    };
+    Inventory &inventory;
+    std::unordered_map<uint64_t, Hold> holds;
+    std::unordered_map<int, int> reserved; // productId -> quantity on hold
+    TimingWheel wheel;
+    uint64_t nextHoldId = 1;
+
+    void unreserve(const Hold &hold)
+    {
+        for (const auto &[productId, quantity] : hold.quantities)
+        {
+            auto it = reserved.find(productId);
+            if ((it->second -= quantity) == 0)
+                reserved.erase(it);
+        }
+    }
+
+public:
+    explicit ReservationBook(Inventory &inventory) : inventory(inventory) {}
+
+    int reservedStock(int productId) const
+    {
+        if (reserved.empty())
+            return 0;
+        auto it = reserved.find(productId);
+        return it == reserved.end() ? 0 : it->second;
+    }
+    size_t activeHolds() const { return holds.size(); }
+
+    // Hold every item of 'order' for 'ttlSeconds'. Returns the hold ID, or 0 with 'reason' set.
+    uint64_t reserve(const Order &order, uint64_t ttlSeconds, uint64_t now, std::string *reason = nullptr)
+    {
+        expire(now);
+        std::map<int, int> wanted;
+        if (!combineOrderLines(order, wanted, reason))
+            return 0;
+        for (const auto &[productId, quantity] : wanted)
+        {
+            Product *product = inventory.getProduct(productId);
+            if (!product)
+            {
+                if (reason)
+                    *reason = "Product ID " + std::to_string(productId) + " not found.";
+                return 0;
+            }
+            int available = product->getStock() - reservedStock(productId);
+            if (available < quantity)
+            {
+                if (reason)
+                    *reason = "Not enough stock for product '" + product->getName() + "' (ID: " + std::to_string(productId) +
+                              "). Available: " + std::to_string(available) + ", Requested: " + std::to_string(quantity) + ".";
+                return 0;
+            }
+        }
+        for (const auto &[productId, quantity] : wanted)
+            reserved[productId] += quantity;
+        uint64_t holdId = nextHoldId++;
+        holds.emplace(holdId, Hold{order, std::move(wanted)});
+        wheel.schedule(holdId, now + ttlSeconds);
+        return holdId;
+    }
+    // Turn a live hold into a stock decrement; the held order is moved to 'confirmed'.
+    // If stock was corrected below a held quantity in the meantime, the hold is released
+    // instead and false is returned with 'reason' set.
+    bool confirm(uint64_t holdId, uint64_t now, Order *confirmed, std::string *reason = nullptr)
+    {
+        expire(now);
+        auto it = holds.find(holdId);
+        if (it == holds.end())
+        {
+            if (reason)
+                *reason = "Hold " + std::to_string(holdId) + " has expired or does not exist.";
+            return false;
+        }
+        unreserve(it->second);
+        for (const auto &[productId, quantity] : it->second.quantities)
+        {
+            Product *product = inventory.getProduct(productId);
+            if (!product || product->getStock() < quantity)
+            {
+                if (reason)
+                    *reason = "Not enough stock left for product ID " + std::to_string(productId) + " (held " +
+                              std::to_string(quantity) + ", in stock " + std::to_string(product ? product->getStock() : 0) +
+                              "). Hold released.";
+                holds.erase(it);
+                return false;
+            }
+        }
+        for (const auto &[productId, quantity] : it->second.quantities)
+            inventory.updateStock(productId, -quantity);
+        if (confirmed)
+            *confirmed = std::move(it->second.order);
+        holds.erase(it);
+        return true;
+    }
+    bool release(uint64_t holdId)
+    {
+        auto it = holds.find(holdId);
+        if (it == holds.end())
+            return false;
+        unreserve(it->second);
+        holds.erase(it);
+        return true;
+    }
+    // Release every hold whose time ran out by 'now'; returns how many expired
+    size_t expire(uint64_t now)
+    {
+        size_t expired = 0;
+        wheel.advance(now, [&](uint64_t holdId)
+                      { expired += release(holdId); });
+        return expired;
+    }
+};
+
+// Fixed-size worker pool; tasks run in submission order
+class ThreadPool
+{
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping = false;
+
+public:
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back([this]
+                                 {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+                        if (tasks.empty())
+                            return;
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                } });
+    }
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename Fn>
+    std::future<decltype(std::declval<Fn>()())> submit(Fn fn)
+    {
+        auto task = std::make_shared<std::packaged_task<decltype(fn())()>>(std::move(fn));
+        auto result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]
+                               { (*task)(); });
+        }
+        ready.notify_one();
+        return result;
+    }
+};
+
+// Member logins: password checks run on a worker pool, and a verified login gets a
+// session token so follow-up requests cost a hash-map lookup instead of an scrypt run.
+class AuthService
+{
+    struct Session
+    {
+        int memberId;
+        std::chrono::steady_clock::time_point expires;
+    };
+    std::mutex sessionMutex;
+    std::unordered_map<std::string, Session> sessions;
+    std::chrono::seconds sessionTtl;
+    size_t loginsSinceSweep = 0;
+    ThreadPool pool; // declared last so workers stop before the session table goes away
+
+    void startSession(const std::string &token, int memberId)
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        if (++loginsSinceSweep >= 1024)
+        {
+            for (auto it = sessions.begin(); it != sessions.end();)
+                it = it->second.expires <= now ? sessions.erase(it) : std::next(it);
+            loginsSinceSweep = 0;
+        }
+        sessions[token] = {memberId, now + sessionTtl};
+    }
+
+public:
+    explicit AuthService(std::chrono::seconds sessionTtl = std::chrono::hours(8))
+        : sessionTtl(sessionTtl) {}
+
+    ThreadPool &workers() { return pool; }
+
+    // Resolves to a new session token, or an empty string if the password does not match
+    std::future<std::string> loginAsync(int memberId, const std::string &passwordHash, const std::string &password)
+    {
+        return pool.submit([this, memberId, passwordHash, password]
+                           {
+            if (!verifyPassword(password, passwordHash))
+                return std::string();
+            std::vector<unsigned char> bytes = randomBytes(16);
+            std::string token = toHex(bytes.data(), bytes.size());
+            startSession(token, memberId);
+            return token; });
+    }
+    // Member ID of a live session, or 0 if the token is unknown or expired
+    int validateSession(const std::string &token)
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        auto it = sessions.find(token);
+        if (it == sessions.end())
+            return 0;
+        if (it->second.expires <= std::chrono::steady_clock::now())
+        {
+            sessions.erase(it);
+            return 0;
+        }
+        return it->second.memberId;
+    }
+    void logout(const std::string &token)
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        sessions.erase(token);
+    }
+    // End every session of a member, e.g. after a password change
+    void revokeMember(int memberId)
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        for (auto it = sessions.begin(); it != sessions.end();)
+            it = it->second.memberId == memberId ? sessions.erase(it) : std::next(it);
+    }
+};
+
+// Bulk import support (CSV/TSV files)
+enum class ImportKind
+{
+    Products,        // id, name, stock, price, supplierId (same layout as products.txt)
+    StockAdjustments // id, delta
+};
+
+struct ImportError
+{
+    size_t line; // 1-based line in the source file, 0 for file-level errors
+    std::string message;
+};
+
+struct ImportReport
+{
+    size_t dataLines = 0; // non-blank lines other than the header
+    size_t rowsRead = 0;  // lines that parsed
+    size_t rowsApplied = 0;
+    double seconds = 0.0;
+    std::vector<ImportError> errors;
+};
+
+// Whichever of tab and comma occurs more often on the first line (tab on a tie), so a
+// stray tab inside a CSV field does not flip the whole file to TSV
+char detectDelimiter(const std::string &data)
+{
+    size_t eol = std::min(data.find('\n'), data.size());
+    auto tabs = std::count(data.begin(), data.begin() + eol, '\t');
+    auto commas = std::count(data.begin(), data.begin() + eol, ',');
+    return tabs >= commas ? '\t' : ',';
+}
+
+// Rows parsed from one chunk; line numbers are chunk-relative until merged
+template <typename Row>
+struct ParsedChunk
+{
+    std::vector<Row> rows;
+    std::vector<size_t> rowLines;
+    std::vector<ImportError> errors;
+    size_t lineCount = 0;
+};
+
+// Split 'data' into line-aligned chunks and parse them on all cores.
+// Results are merged back in file order with absolute line numbers.
+template <typename Row, typename ParseRow>
+void parseChunked(const std::string &data, ParseRow parseRow,
+                  std::vector<Row> &rows, std::vector<size_t> &rowLines, std::vector<ImportError> &errors)
+{
+    const char delim = detectDelimiter(data);
+    const size_t minChunkBytes = 1 << 16;
+    size_t workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = std::max<size_t>(1, std::min(workers, data.size() / minChunkBytes));
+
+    std::vector<size_t> bounds{0};
+    for (size_t i = 1; i < workers; ++i)
+    {
+        size_t eol = data.find('\n', std::max(bounds.back(), data.size() * i / workers));
+        if (eol == std::string::npos)
+            break;
+        bounds.push_back(eol + 1);
+    }
+    bounds.push_back(data.size());
+
+    std::vector<ParsedChunk<Row>> chunks(bounds.size() - 1);
+    auto parseChunk = [&](size_t c)
+    {
+        SIP_ZONE("parseChunked/chunk");
+        ParsedChunk<Row> &chunk = chunks[c];
+        const char *p = data.data() + bounds[c];
+        const char *chunkEnd = data.data() + bounds[c + 1];
+        std::string error;
+        while (p < chunkEnd)
+        {
+            const char *eol = static_cast<const char *>(std::memchr(p, '\n', chunkEnd - p));
+            const char *next = eol ? eol + 1 : chunkEnd;
+            const char *lineEnd = eol ? eol : chunkEnd;
+            if (lineEnd > p && lineEnd[-1] == '\r')
+                --lineEnd;
+            ++chunk.lineCount;
+            bool isHeader = c == 0 && chunk.lineCount == 1 && lineEnd > p && !std::isdigit(static_cast<unsigned char>(*p)) && *p != '-';
+            if (lineEnd > p && !isHeader)
+            {
+                Row row;
+                if (parseRow(p, lineEnd, delim, row, error))
+                {
+                    chunk.rows.push_back(std::move(row));
+                    chunk.rowLines.push_back(chunk.lineCount);
+                }
+                else
+                {
+                    chunk.errors.push_back({chunk.lineCount, error});
+                }
+            }
+            p = next;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t c = 1; c < chunks.size(); ++c)
+        threads.emplace_back(parseChunk, c);
+    if (!chunks.empty())
+        parseChunk(0);
+    for (auto &t : threads)
+        t.join();
+
+    size_t lineOffset = 0, total = 0;
+    for (const auto &chunk : chunks)
+        total += chunk.rows.size();
+    rows.reserve(total);
+    rowLines.reserve(total);
+    for (auto &chunk : chunks)
+    {
+        std::move(chunk.rows.begin(), chunk.rows.end(), std::back_inserter(rows));
+        for (size_t line : chunk.rowLines)
+            rowLines.push_back(line + lineOffset);
+        for (auto &e : chunk.errors)
+            errors.push_back({e.line + lineOffset, std::move(e.message)});
+        lineOffset += chunk.lineCount;
+    }
+}
+
 // Warehouse class
 class Warehouse
 {
@@ -174,6 +1626,13 @@ class Warehouse
     std::map<int, Supplier> suppliers;
     std::map<int, Member> members;
     std::vector<Order> orders;
+    ReservationBook reservations{inventory};
+    AuthService auth;
+
+    static uint64_t nowSeconds()
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 
 public:
     void addSupplier(const Supplier &supplier)
@@ -188,39 +1647,226 @@ public:
     {
         inventory.addProduct(product);
     }
-    void processOrder(const Order &order)
+    void addProducts(const std::vector<Product> &products)
+    {
+        inventory.addProducts(products);
+    }
+    std::vector<size_t> applyBatch(const std::vector<StockDelta> &deltas)
+    {
+        return inventory.applyBatch(deltas);
+    }
+    // Parse a CSV/TSV file in parallel and apply all valid rows in one batch.
+    // Invalid rows are skipped and reported with their line number.
+    ImportReport importFile(const std::string &path, ImportKind kind)
+    {
+        SIP_ZONE("Warehouse::importFile");
+        ImportReport report;
+        auto start = std::chrono::steady_clock::now();
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+        {
+            report.errors.push_back({0, "cannot open file '" + path + "'"});
+            return report;
+        }
+        std::string data;
+        in.seekg(0, std::ios::end);
+        std::streamoff size = in.tellg();
+        if (size < 0)
+        {
+            report.errors.push_back({0, "cannot read file '" + path + "'"});
+            return report;
+        }
+        data.resize(static_cast<size_t>(size));
+        in.seekg(0, std::ios::beg);
+        in.read(&data[0], data.size());
+        in.close();
+
+        std::vector<size_t> rowLines;
+        if (kind == ImportKind::Products)
+        {
+            std::vector<Product> rows;
+            parseChunked(data, RecordCodec<Product>::readRow, rows, rowLines, report.errors);
+            report.rowsRead = rows.size();
+            report.dataLines = rows.size() + report.errors.size();
+            addProducts(rows);
+            report.rowsApplied = rows.size();
+        }
+        else
+        {
+            std::vector<StockDelta> rows;
+            parseChunked(data, RecordCodec<StockDelta>::readRow, rows, rowLines, report.errors);
+            report.rowsRead = rows.size();
+            report.dataLines = rows.size() + report.errors.size();
+            auto rejected = applyBatch(rows);
+            for (size_t i : rejected)
+                report.errors.push_back({rowLines[i], "product ID " + std::to_string(rows[i].productId) + " not found"});
+            report.rowsApplied = rows.size() - rejected.size();
+        }
+        std::sort(report.errors.begin(), report.errors.end(), [](const ImportError &a, const ImportError &b)
+                  { return a.line < b.line; });
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+    // Validate and commit an order without console output.
+    // On rejection nothing is changed and 'reason' (if given) says why.
+    bool tryProcessOrder(const Order &order, std::string *reason = nullptr)
     {
+        SIP_ZONE("Warehouse::processOrder");
+        reservations.expire(nowSeconds());
+        std::map<int, int> quantities;
+        if (!combineOrderLines(order, quantities, reason))
+            return false;
         // First, check if all items are available in sufficient quantity
-        for (const auto &item : order.getItems())
+        std::vector<Product *> resolved;
+        for (const auto &[productId, quantity] : quantities)
         {
-            Product *product = inventory.getProduct(item.getProductId());
+            Product *product = inventory.getProduct(productId);
             if (!product)
             {
-                std::cout << "Product ID " << item.getProductId() << " not found. Order not processed.\n";
-                pause();
-                return;
+                if (reason)
+                    *reason = "Product ID " + std::to_string(productId) + " not found.";
+                return false;
             }
-            if (product->getStock() < item.getQuantity())
+            int available = product->getStock() - reservations.reservedStock(productId);
+            if (available < quantity)
             {
-                std::cout << "Not enough stock for product '" << product->getName()
-                          << "' (ID: " << product->getId() << "). Available: "
-                          << product->getStock() << ", Requested: " << item.getQuantity() << ".\n";
-                std::cout << "Order not processed.\n";
-                pause();
-                return;
+                if (reason)
+                    *reason = "Not enough stock for product '" + product->getName() + "' (ID: " + std::to_string(productId) +
+                              "). Available: " + std::to_string(available) + ", Requested: " + std::to_string(quantity) + ".";
+                return false;
             }
+            resolved.push_back(product);
         }
         // If all checks pass, process the order
-        for (const auto &item : order.getItems())
+        size_t i = 0;
+        for (const auto &[productId, quantity] : quantities)
         {
-            inventory.updateStock(item.getProductId(), -item.getQuantity());
+            resolved[i++]->updateStock(-quantity);
         }
         orders.push_back(order);
-        std::cout << "Order processed!\n";
-        pause();
+        return true;
+    }
+    // Commit a burst of orders in one pass. Orders are validated in arrival order against a
+    // running per-product total, so each order is still all-or-nothing and sees the stock left
+    // by the ones before it. Each product is looked up once, and each one gets a single
+    // combined decrement at the end. Accepts exactly the orders that tryProcessOrder would
+    // accept one at a time. Returns 1 for each accepted order, 0 for each rejected one.
+    std::vector<char> processOrders(const Order *first, const Order *last)
+    {
+        SIP_ZONE("Warehouse::processOrders");
+        struct Slot
+        {
+            Product *product;
+            int available; // stock minus holds when the batch started
+            int taken;     // committed by earlier orders in this batch
+            int pending;   // requested by the order being checked
+        };
+        reservations.expire(nowSeconds());
+        std::unordered_map<int, Slot> slots;
+        std::vector<Slot *> touched;
+        std::vector<char> accepted(last - first, 0);
+        for (const Order *order = first; order != last; ++order)
+        {
+            bool ok = true;
+            touched.clear();
+            for (const auto &item : order->getItems())
+            {
+                auto [it, inserted] = slots.try_emplace(item.getProductId());
+                Slot &slot = it->second;
+                if (inserted)
+                {
+                    slot.product = inventory.getProduct(item.getProductId());
+                    slot.available = slot.product ? slot.product->getStock() - reservations.reservedStock(item.getProductId()) : 0;
+                    slot.taken = slot.pending = 0;
+                }
+                if (slot.pending == 0)
+                    touched.push_back(&slot);
+                slot.pending += item.getQuantity();
+                // Same rule as combineOrderLines: positive lines, checked per product total
+                if (item.getQuantity() <= 0 || !slot.product || slot.taken + slot.pending > slot.available)
+                {
+                    ok = false;
+                    break;
+                }
+            }
+            for (Slot *slot : touched)
+            {
+                if (ok)
+                    slot->taken += slot->pending;
+                slot->pending = 0;
+            }
+            if (ok)
+            {
+                accepted[order - first] = 1;
+                orders.push_back(*order);
+            }
+        }
+        for (auto &[productId, slot] : slots)
+            if (slot.taken != 0)
+                slot.product->updateStock(-slot.taken);
+        return accepted;
+    }
+    std::vector<char> processOrders(const std::vector<Order> &batch)
+    {
+        return processOrders(batch.data(), batch.data() + batch.size());
+    }
+    void processOrder(const Order &order)
+    {
+        std::string reason;
+        if (tryProcessOrder(order, &reason))
+            std::cout << "Order processed!\n";
+        else
+            std::cout << reason << "\nOrder not processed.\n";
+        pauseScreen();
+    }
+    // Checkout holds: reserve an order's stock for a while, then confirm or release it.
+    // reserveOrder returns 0 (with 'reason' set) when the stock is not available.
+    uint64_t reserveOrder(const Order &order, int minutes, std::string *reason = nullptr)
+    {
+        return reservations.reserve(order, static_cast<uint64_t>(std::max(minutes, 0)) * 60, nowSeconds(), reason);
+    }
+    // Commits the held stock and records the order. False (with 'reason' set) if the hold
+    // expired, is unknown, or stock was corrected below the held amount since it was placed.
+    bool confirmHold(uint64_t holdId, std::string *reason = nullptr)
+    {
+        Order confirmed(0, 0);
+        if (!reservations.confirm(holdId, nowSeconds(), &confirmed, reason))
+            return false;
+        orders.push_back(confirmed);
+        return true;
+    }
+    bool releaseHold(uint64_t holdId)
+    {
+        return reservations.release(holdId);
+    }
+    size_t expireHolds()
+    {
+        return reservations.expire(nowSeconds());
+    }
+    // Stock not on hold; never negative, even after a correction below the held amount
+    int availableStock(int productId)
+    {
+        Product *product = inventory.getProduct(productId);
+        return product ? std::max(0, product->getStock() - reservations.reservedStock(productId)) : 0;
+    }
+    const std::vector<Order> &getOrders() const
+    {
+        return orders;
+    }
+    std::vector<Product> getAllProducts() const
+    {
+        return inventory.getAllProducts();
+    }
+    long long totalStock() const
+    {
+        long long total = 0;
+        for (const auto &product : inventory.getAllProducts())
+            total += product.getStock();
+        return total;
     }
     void showLowStock(int threshold)
     {
+        SIP_ZONE("Warehouse::showLowStock");
         auto lowStock = inventory.getLowStockProducts(threshold);
         for (const auto &product : lowStock)
         {
@@ -229,72 +1875,81 @@ public:
     }
     void showAllStock() const
     {
-        auto all = inventory.getAllProducts();
-        std::cout << "\n--- Current Stock ---\n";
-        if (all.empty())
         {
-            std::cout << "No products in stock.\n";
-        }
-        else
-        {
-            std::cout << std::left
-                      << std::setw(8) << "ID"
-                      << std::setw(25) << "Name"
-                      << std::setw(8) << "Stock"
-                      << std::setw(10) << "Price"
-                      << std::setw(12) << "SupplierID" << '\n';
-            for (const auto &product : all)
+            SIP_ZONE("Warehouse::showAllStock"); // report rendering only, not the wait for Enter
+            auto all = inventory.getAllProducts();
+            std::cout << "\n--- Current Stock ---\n";
+            if (all.empty())
+            {
+                std::cout << "No products in stock.\n";
+            }
+            else
             {
                 std::cout << std::left
-                          << std::setw(8) << product.getId()
-                          << std::setw(25) << product.getName()
-                          << std::setw(8) << product.getStock()
-                          << std::setw(10) << product.getPrice()
-                          << std::setw(12) << product.getSupplierId() << '\n';
+                          << std::setw(8) << "ID"
+                          << std::setw(25) << "Name"
+                          << std::setw(8) << "Stock"
+                          << std::setw(10) << "Price"
+                          << std::setw(12) << "SupplierID" << '\n';
+                for (const auto &product : all)
+                {
+                    std::cout << std::left
+                              << std::setw(8) << product.getId()
+                              << std::setw(25) << product.getName()
+                              << std::setw(8) << product.getStock()
+                              << std::setw(10) << product.getPrice()
+                              << std::setw(12) << product.getSupplierId() << '\n';
+                }
             }
         }
-        pause();
+        pauseScreen();
     }
     void showSupplierList() const
     {
-        std::cout << "\n--- Supplier List ---\n";
-        if (suppliers.empty())
-        {
-            std::cout << "No suppliers available.\n";
-        }
-        else
         {
-            std::cout << std::left
-                      << std::setw(8) << "ID"
-                      << std::setw(25) << "Name"
-                      << std::setw(30) << "Contact" << '\n';
-            for (const auto &[id, supplier] : suppliers)
+            SIP_ZONE("Warehouse::showSupplierList");
+            std::cout << "\n--- Supplier List ---\n";
+            if (suppliers.empty())
+            {
+                std::cout << "No suppliers available.\n";
+            }
+            else
             {
                 std::cout << std::left
-                          << std::setw(8) << supplier.getId()
-                          << std::setw(25) << supplier.getName()
-                          << std::setw(30) << supplier.getContact() << '\n';
+                          << std::setw(8) << "ID"
+                          << std::setw(25) << "Name"
+                          << std::setw(30) << "Contact" << '\n';
+                for (const auto &[id, supplier] : suppliers)
+                {
+                    std::cout << std::left
+                              << std::setw(8) << supplier.getId()
+                              << std::setw(25) << supplier.getName()
+                              << std::setw(30) << supplier.getContact() << '\n';
+                }
             }
         }
-        pause();
+        pauseScreen();
     }
 
     void showMemberList() const
     {
-        std::cout << "\n--- Member List ---\n";
-        if (members.empty())
-        {
-            std::cout << "No members available.\n";
-        }
-        else
         {
-            std::cout << "ID\tName\tRole\n";
-            for (const auto &[id, member] : members)
+            SIP_ZONE("Warehouse::showMemberList");
+            std::cout << "\n--- Member List ---\n";
+            if (members.empty())
+            {
+                std::cout << "No members available.\n";
+            }
+            else
             {
-                std::cout << member.getId() << "\t" << member.getName() << "\t" << member.getRole() << "\n";
+                std::cout << "ID\tName\tRole\n";
+                for (const auto &[id, member] : members)
+                {
+                    std::cout << member.getId() << "\t" << member.getName() << "\t" << member.getRole() << "\n";
+                }
             }
         }
-        pause();
+        pauseScreen();
     }
 
     // Add function to count orders by member
@@ -311,27 +1966,61 @@ public:
 
     void showMemberOrderCounts() const
     {
-        std::cout << "\n--- Member Order Counts ---\n";
-        if (members.empty())
-        {
-            std::cout << "No members available.\n";
-        }
-        else
         {
-            std::cout << "ID\tName\tRole\tOrder Count\n";
-            for (const auto &[id, member] : members)
+            SIP_ZONE("Warehouse::showMemberOrderCounts");
+            std::cout << "\n--- Member Order Counts ---\n";
+            if (members.empty())
             {
-                int orderCount = 0;
-                for (const auto &order : orders)
+                std::cout << "No members available.\n";
+            }
+            else
+            {
+                std::cout << "ID\tName\tRole\tOrder Count\n";
+                for (const auto &[id, member] : members)
                 {
-                    if (order.getMemberId() == id)
-                        ++orderCount;
+                    int orderCount = 0;
+                    for (const auto &order : orders)
+                    {
+                        if (order.getMemberId() == id)
+                            ++orderCount;
+                    }
+                    std::cout << member.getId() << "\t" << member.getName() << "\t"
+                              << member.getRole() << "\t" << orderCount << "\n";
                 }
-                std::cout << member.getId() << "\t" << member.getName() << "\t"
-                          << member.getRole() << "\t" << orderCount << "\n";
             }
         }
-        pause();
+        pauseScreen();
+    }
+
+    // Verify a member's password on the auth pool; yields a session token, or "" on failure
+    std::future<std::string> loginAsync(int memberId, const std::string &password)
+    {
+        Member *member = getMemberById(memberId);
+        if (!member)
+        {
+            std::promise<std::string> rejected;
+            rejected.set_value("");
+            return rejected.get_future();
+        }
+        return auth.loginAsync(memberId, member->getPasswordHash(), password);
+    }
+    int validateSession(const std::string &token)
+    {
+        return auth.validateSession(token);
+    }
+    void logout(const std::string &token)
+    {
+        auth.logout(token);
+    }
+    // Sessions issued under the old password stop validating
+    bool changeMemberPassword(int memberId, const std::string &newPassword)
+    {
+        Member *member = getMemberById(memberId);
+        if (!member)
+            return false;
+        member->setPassword(newPassword);
+        auth.revokeMember(memberId);
+        return true;
     }
 
     Product *getProductById(int id)
@@ -353,71 +2042,136 @@ public:
         return nullptr;
     }
 
-    // Data persistence functions
+    // Data persistence functions (record layouts come from the Schema specializations)
     void saveData() const {
-        // Save products
+        SIP_ZONE("Warehouse::saveData");
         std::ofstream pf("products.txt");
+        pf << RecordCodec<Product>::header() << '\n';
         for (const auto& product : inventory.getAllProducts()) {
-            pf << product.getId() << '\t' << product.getName() << '\t' << product.getStock() << '\t' << product.getPrice() << '\t' << product.getSupplierId() << '\n';
+            RecordCodec<Product>::writeText(pf, product);
         }
         pf.close();
-        // Save suppliers
         std::ofstream sf("suppliers.txt");
+        sf << RecordCodec<Supplier>::header() << '\n';
         for (const auto& [id, supplier] : suppliers) {
-            sf << supplier.getId() << '\t' << supplier.getName() << '\t' << supplier.getContact() << '\n';
+            RecordCodec<Supplier>::writeText(sf, supplier);
         }
         sf.close();
-        // Save members (write one line per member, include password)
         std::ofstream mf("members.txt");
+        mf << RecordCodec<Member>::header() << '\n';
         for (const auto& [id, member] : members) {
-            mf << member.getId() << '\t' << member.getName() << '\t' << member.getRole() << '\t' << member.getPassword() << '\n';
+            RecordCodec<Member>::writeText(mf, member);
         }
         mf.close();
     }
-    void loadData() {
-        // Load products
-        std::ifstream pf("products.txt");
-        if (pf.is_open()) {
-            std::string line;
-            while (std::getline(pf, line)) {
-                std::istringstream iss(line);
-                int id, stock, supplierId;
-                double price;
-                std::string name;
-                if (iss >> id && iss.get() == '\t' && std::getline(iss, name, '\t') && iss >> stock && iss.get() == '\t' && iss >> price && iss.get() == '\t' && iss >> supplierId) {
-                    addProduct(Product(id, name, stock, price, supplierId));
-                }
-            }
-            pf.close();
-        }
-        // Load suppliers
-        std::ifstream sf("suppliers.txt");
-        if (sf.is_open()) {
-            std::string line;
-            while (std::getline(sf, line)) {
-                std::istringstream iss(line);
-                int id;
-                std::string name, contact;
-                if (iss >> id && iss.get() == '\t' && std::getline(iss, name, '\t') && std::getline(iss, contact)) {
-                    addSupplier(Supplier(id, name, contact));
-                }
+    // Returns false if a file was written by a newer schema version; nothing should be saved over it then
+    bool loadData() {
+        SIP_ZONE("Warehouse::loadData");
+        int productVersion, supplierVersion, memberVersion;
+        std::vector<Member> memberRows;
+        if (!loadTable<Product>("products.txt", [this](const Product& p) { addProduct(p); }, productVersion) ||
+            !loadTable<Supplier>("suppliers.txt", [this](const Supplier& s) { addSupplier(s); }, supplierVersion) ||
+            !loadTable<Member>("members.txt", [&memberRows](const Member& m) { memberRows.push_back(m); }, memberVersion))
+            return false;
+        if (memberVersion < 2) migrateLegacyPasswords(memberRows);
+        for (const auto& m : memberRows) addMember(m);
+        return true;
+    }
+    // Hash the plaintext passwords of rows read from a pre-v2 members table; the hashes are
+    // written on the next save. Only pass rows from such a table: hashing a hash locks the member out.
+    void migrateLegacyPasswords(std::vector<Member>& legacyRows) {
+        std::vector<std::future<void>> jobs;
+        for (auto& member : legacyRows) {
+            Member* m = &member;
+            jobs.push_back(auth.workers().submit([m] { m->hashLegacyPassword(); }));
+        }
+        for (auto& job : jobs) job.get();
+    }
+
+    // Binary snapshot of all three tables; each table carries its schema version and record count
+    bool saveSnapshot(const std::string& path) const {
+        std::string out = "SIPSNAP\n";
+        auto products = inventory.getAllProducts();
+        appendTable<Product>(out, products.size(), [&](std::string& buf) {
+            for (const auto& product : products) RecordCodec<Product>::writeBinary(buf, product);
+        });
+        appendTable<Supplier>(out, suppliers.size(), [&](std::string& buf) {
+            for (const auto& [id, supplier] : suppliers) RecordCodec<Supplier>::writeBinary(buf, supplier);
+        });
+        appendTable<Member>(out, members.size(), [&](std::string& buf) {
+            for (const auto& [id, member] : members) RecordCodec<Member>::writeBinary(buf, member);
+        });
+        std::ofstream f(path, std::ios::binary);
+        f.write(out.data(), out.size());
+        return static_cast<bool>(f);
+    }
+    bool loadSnapshot(const std::string& path) {
+        std::ifstream f(path, std::ios::binary);
+        if (!f.is_open()) return false;
+        std::string data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        if (data.compare(0, 8, "SIPSNAP\n") != 0) return false;
+        const char* p = data.data() + 8;
+        const char* end = data.data() + data.size();
+        std::vector<Product> products;
+        std::vector<Supplier> supplierRows;
+        std::vector<Member> memberRows;
+        int productVersion, supplierVersion, memberVersion;
+        if (!readTable(p, end, products, productVersion) || !readTable(p, end, supplierRows, supplierVersion) ||
+            !readTable(p, end, memberRows, memberVersion) || p != end)
+            return false;
+        addProducts(products);
+        for (const auto& s : supplierRows) addSupplier(s);
+        if (memberVersion < 2) migrateLegacyPasswords(memberRows);
+        for (const auto& m : memberRows) addMember(m);
+        return true;
+    }
+
+private:
+    template <typename T, typename Add>
+    static bool loadTable(const char* path, Add add, int& fileVersion) {
+        fileVersion = RecordCodec<T>::version; // nothing to migrate when the file does not exist
+        std::ifstream in(path);
+        if (!in.is_open()) return true;
+        std::string line, error;
+        fileVersion = 1; // files without a header predate schema versioning
+        bool firstLine = true;
+        while (std::getline(in, line)) {
+            if (firstLine && !line.empty() && line[0] == '#') {
+                firstLine = false;
+                if (!RecordCodec<T>::readHeader(line, fileVersion)) return false;
+                continue;
             }
-            sf.close();
-        }
-        // Load members (read password field)
-        std::ifstream mf("members.txt");
-        if (mf.is_open()) {
-            std::string line;
-            while (std::getline(mf, line)) {
-                std::istringstream iss(line);
-                int id;
-                std::string name, role, password;
-                if (iss >> id && iss.get() == '\t' && std::getline(iss, name, '\t') && std::getline(iss, role, '\t') && std::getline(iss, password)) {
-                    addMember(Member(id, name, role, password));
-                }
+            firstLine = false;
+            const char* end = line.data() + line.size();
+            if (!line.empty() && line.back() == '\r') --end;
+            T record;
+            if (RecordCodec<T>::readText(line.data(), end, '\t', record, error, fileVersion)) {
+                add(record);
             }
-            mf.close();
         }
+        return true;
+    }
+    template <typename T, typename WriteRecords>
+    static void appendTable(std::string& out, size_t count, WriteRecords writeRecords) {
+        writeFieldBinary(out, std::string(Schema<T>::name));
+        writeFieldBinary(out, static_cast<int>(RecordCodec<T>::version));
+        writeFieldBinary(out, static_cast<uint32_t>(count));
+        writeRecords(out);
+    }
+    template <typename T>
+    static bool readTable(const char*& p, const char* end, std::vector<T>& rows, int& fileVersion) {
+        std::string name;
+        uint32_t count;
+        if (!readFieldBinary(p, end, name) || name != Schema<T>::name ||
+            !readFieldBinary(p, end, fileVersion) || fileVersion < 1 || fileVersion > RecordCodec<T>::version ||
+            !readFieldBinary(p, end, count))
+            return false;
+        if (count > static_cast<size_t>(end - p)) return false; // every record takes at least one byte
+        rows.resize(count);
+        for (auto& row : rows) {
+            if (!RecordCodec<T>::readBinary(p, end, row, fileVersion)) return false;
+        }
+        return true;
     }
 };
 
@@ -441,6 +2195,26 @@ void logError(const std::string &message)
     }
 }
 
+// Print an import summary; every row error is also written to error.log
+void printImportReport(const std::string &path, const ImportReport &report)
+{
+    const size_t maxShown = 20;
+    std::cout << "Imported " << report.rowsApplied << " of " << report.dataLines
+              << " rows from '" << path << "' in " << std::fixed << std::setprecision(3) << report.seconds << "s";
+    if (report.seconds > 0)
+        std::cout << " (" << static_cast<long long>(report.rowsRead / report.seconds) << " rows/s)";
+    std::cout << std::defaultfloat << "\n";
+    for (size_t i = 0; i < report.errors.size(); ++i)
+    {
+        const ImportError &e = report.errors[i];
+        if (i < maxShown)
+            std::cout << "  line " << e.line << ": " << e.message << "\n";
+        logError("Import '" + path + "' line " + std::to_string(e.line) + ": " + e.message);
+    }
+    if (report.errors.size() > maxShown)
+        std::cout << "  ... " << report.errors.size() - maxShown << " more errors (see error.log)\n";
+}
+
 // Update inputInt to log errors
 int inputInt(const std::string &prompt)
 {
@@ -548,7 +2322,8 @@ void showMainMenu()
     std::cout << "9. Show Supplier List\n";
     std::cout << "10. Show Member List\n";
     std::cout << "11. Show Member Order\n";
-    std::cout << "12. Exit\n";
+    std::cout << "12. Bulk Import\n";
+    std::cout << "13. Exit\n";
     std::cout << "Select an option: ";
 }
 
@@ -561,7 +2336,7 @@ void addProductUI(Warehouse &warehouse)
     int supplierId = inputInt("Supplier ID: ");
     warehouse.addProduct(Product(id, name, stock, price, supplierId));
     std::cout << "Product added successfully!\n";
-    pause();
+    pauseScreen();
 }
 
 void addSupplierUI(Warehouse &warehouse)
@@ -573,7 +2348,7 @@ void addSupplierUI(Warehouse &warehouse)
     std::string contact = inputString("Contact: ");
     warehouse.addSupplier(Supplier(id, name, contact));
     std::cout << "Supplier added successfully!\n";
-    pause();
+    pauseScreen();
 }
 
 void addMemberUI(Warehouse &warehouse)
@@ -587,7 +2362,7 @@ void addMemberUI(Warehouse &warehouse)
     warehouse.addMember(Member(id, name, role, password));
     std::cout << "Member added successfully!\n";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Clear buffer before pause
-    pause();
+    pauseScreen();
 }
 
 void processOrderUI(Warehouse &warehouse)
@@ -613,7 +2388,7 @@ void processOrderUI(Warehouse &warehouse)
     }
     warehouse.processOrder(order);
     std::cout << "Order processed!\n";
-    pause();
+    pauseScreen();
 }
 
 void showLowStockUI(Warehouse &warehouse)
@@ -624,7 +2399,7 @@ void showLowStockUI(Warehouse &warehouse)
     std::cout << "Enter stock threshold: ";
     std::cin >> threshold;
     warehouse.showLowStock(threshold);
-    pause();
+    pauseScreen();
 }
 
 void editProductUI(Warehouse &warehouse)
@@ -636,7 +2411,7 @@ void editProductUI(Warehouse &warehouse)
     if (!product)
     {
         std::cout << "Product not found.\n";
-        pause();
+        pauseScreen();
         return;
     }
     std::cout << "Editing Product: " << product->getName() << "\n";
@@ -695,7 +2470,7 @@ void editProductUI(Warehouse &warehouse)
     }
 
     std::cout << "Product updated successfully!\n";
-    pause();
+    pauseScreen();
 }
 
 void editSupplierUI(Warehouse &warehouse)
@@ -707,7 +2482,7 @@ void editSupplierUI(Warehouse &warehouse)
     if (!supplier)
     {
         std::cout << "Supplier not found.\n";
-        pause();
+        pauseScreen();
         return;
     }
     std::cout << "Editing Supplier: " << supplier->getName() << "\n";
@@ -725,7 +2500,7 @@ void editSupplierUI(Warehouse &warehouse)
         supplier->setContact(input);
 
     std::cout << "Supplier updated successfully!\n";
-    pause();
+    pauseScreen();
 }
 
 void editMemberUI(Warehouse &warehouse)
@@ -737,7 +2512,7 @@ void editMemberUI(Warehouse &warehouse)
     if (!member)
     {
         std::cout << "Member not found.\n";
-        pause();
+        pauseScreen();
         return;
     }
     std::cout << "Editing Member: " << member->getName() << "\n";
@@ -757,17 +2532,630 @@ void editMemberUI(Warehouse &warehouse)
     std::cout << "New Password [hidden]: ";
     std::getline(std::cin, input);
     if (!input.empty())
-        member->setPassword(input);
+        warehouse.changeMemberPassword(id, input);
 
     std::cout << "Member updated successfully!\n";
-    pause();
+    pauseScreen();
+}
+
+void bulkImportUI(Warehouse &warehouse)
+{
+    clearScreen();
+    std::cout << "--- Bulk Import ---\n";
+    std::cout << "1. Products (id, name, stock, price, supplierId)\n";
+    std::cout << "2. Stock adjustments (id, delta)\n";
+    int kind = inputInt("Select import type: ");
+    if (kind != 1 && kind != 2)
+    {
+        std::cout << "Invalid import type.\n";
+        pauseScreen();
+        return;
+    }
+    std::string path = inputString("CSV/TSV file path: ");
+    ImportReport report = warehouse.importFile(path, kind == 1 ? ImportKind::Products : ImportKind::StockAdjustments);
+    printImportReport(path, report);
+    pauseScreen();
+}
+
+// Value at quantile q (0..1) of an ascending-sorted sample
+double percentile(const std::vector<double> &sorted, double q)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t index = static_cast<size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Simulates a login storm: many concurrent logins, then session checks against the token cache
+void benchAuth(size_t logins)
+{
+    const int memberCount = 8;
+    Warehouse warehouse;
+    for (int id = 1; id <= memberCount; ++id)
+        warehouse.addMember(Member(id, "Member " + std::to_string(id), "employee", "pass" + std::to_string(id)));
+
+    // The pool runs tasks in FIFO order, so waiting on the futures in order closely tracks completion times
+    std::vector<std::chrono::steady_clock::time_point> submitted(logins);
+    std::vector<std::future<std::string>> pending;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < logins; ++i)
+    {
+        int id = static_cast<int>(i % memberCount) + 1;
+        submitted[i] = std::chrono::steady_clock::now();
+        pending.push_back(warehouse.loginAsync(id, i % 10 == 9 ? "wrong" : "pass" + std::to_string(id)));
+    }
+    std::vector<double> latencyMs;
+    std::vector<std::string> tokens;
+    for (size_t i = 0; i < logins; ++i)
+    {
+        std::string token = pending[i].get();
+        latencyMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submitted[i]).count());
+        if (!token.empty())
+            tokens.push_back(token);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(latencyMs.begin(), latencyMs.end());
+    std::cout << std::fixed << std::setprecision(1)
+              << "Logins: " << logins << " (" << tokens.size() << " accepted) in " << seconds << "s, "
+              << logins / seconds << " logins/s\n"
+              << "Login latency ms: p50 " << percentile(latencyMs, 0.50) << ", p95 " << percentile(latencyMs, 0.95)
+              << ", p99 " << percentile(latencyMs, 0.99) << ", max " << latencyMs.back() << "\n";
+
+    const size_t checks = 1000000;
+    size_t valid = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < checks && !tokens.empty(); ++i)
+        valid += warehouse.validateSession(tokens[i % tokens.size()]) != 0;
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Session checks: " << valid << " valid, " << static_cast<long long>(checks / seconds) << " checks/s, "
+              << seconds * 1e9 / checks << " ns each\n"
+              << std::defaultfloat;
+}
+
+// Load simulation: a seeded order generator plus a replay driver for capacity planning.
+// Only raw mt19937_64 output is used (its sequence is fixed by the standard), so a seed
+// produces the same order stream with every compiler.
+struct LoadProfile
+{
+    uint64_t seed = 42;
+    size_t orders = 100000;
+    int products = 1000;
+    int members = 200;
+    double skew = 1.1;          // Zipf exponent for SKU popularity; 0 is uniform
+    int minItems = 1;           // distinct SKUs per order
+    int maxItems = 5;
+    int maxQuantity = 4;        // per item
+    double employeeShare = 0.2; // fraction of members (and of orders) that are employees
+    double stockOutRate = 0.05; // fraction of SKUs that start with no stock
+    int initialStock = 50000;
+    size_t threads = 1;
+    size_t batch = 1; // orders per commit; above 1 uses Warehouse::processOrders
+};
+
+class SimulationRandom
+{
+    std::mt19937_64 engine;
+
+public:
+    explicit SimulationRandom(uint64_t seed) : engine(seed) {}
+    double unit() { return (engine() >> 11) * (1.0 / 9007199254740992.0); } // [0, 1)
+    uint64_t below(uint64_t n) { return static_cast<uint64_t>(unit() * n); }
+    int between(int lo, int hi) { return lo + static_cast<int>(below(static_cast<uint64_t>(hi - lo + 1))); }
+};
+
+// Samples ranks 0..n-1 with P(rank k) proportional to 1/(k+1)^skew
+class ZipfSampler
+{
+    std::vector<double> cdf;
+
+public:
+    ZipfSampler(size_t n, double skew) : cdf(n)
+    {
+        double sum = 0;
+        for (size_t k = 0; k < n; ++k)
+            cdf[k] = sum += 1.0 / std::pow(static_cast<double>(k + 1), skew);
+        for (auto &c : cdf)
+            c /= sum;
+    }
+    size_t sample(SimulationRandom &rng) const
+    {
+        size_t rank = std::upper_bound(cdf.begin(), cdf.end(), rng.unit()) - cdf.begin();
+        return std::min(rank, cdf.size() - 1);
+    }
+};
+
+// Catalog for a profile: product IDs 1..products, a seeded subset starting out of stock
+void seedSimulationWarehouse(Warehouse &warehouse, const LoadProfile &profile)
+{
+    SimulationRandom rng(profile.seed ^ 0x5eed5eedULL);
+    std::vector<Product> products;
+    for (int id = 1; id <= profile.products; ++id)
+    {
+        int stock = rng.unit() < profile.stockOutRate ? 0 : profile.initialStock;
+        products.emplace_back(id, "SKU " + std::to_string(id), stock, 1.0 + id % 100, 1);
+    }
+    warehouse.addProducts(products);
+}
+
+std::vector<Order> generateOrders(const LoadProfile &profile)
+{
+    SimulationRandom rng(profile.seed);
+    ZipfSampler zipf(profile.products, profile.skew);
+
+    // Shuffle which product IDs are the hot ones
+    std::vector<int> productForRank(profile.products);
+    for (int i = 0; i < profile.products; ++i)
+        productForRank[i] = i + 1;
+    for (size_t i = productForRank.size(); i > 1; --i)
+        std::swap(productForRank[i - 1], productForRank[rng.below(i)]);
+
+    // Member IDs 1..employees are employees, the rest customers
+    int employees = std::max(1, static_cast<int>(profile.members * profile.employeeShare));
+    int maxItems = std::min(profile.maxItems, profile.products);
+    std::vector<Order> orders;
+    orders.reserve(profile.orders);
+    std::vector<int> picked;
+    for (size_t i = 0; i < profile.orders; ++i)
+    {
+        bool employee = rng.unit() < profile.employeeShare || employees == profile.members;
+        int memberId = employee ? rng.between(1, employees) : rng.between(employees + 1, profile.members);
+        Order order(static_cast<int>(i + 1), memberId);
+        int items = rng.between(std::min(profile.minItems, maxItems), maxItems);
+        picked.clear();
+        while (static_cast<int>(picked.size()) < items)
+        {
+            int productId = productForRank[zipf.sample(rng)];
+            if (std::find(picked.begin(), picked.end(), productId) != picked.end())
+                continue;
+            picked.push_back(productId);
+            order.addItem(OrderItem(productId, rng.between(1, profile.maxQuantity)));
+        }
+        orders.push_back(order);
+    }
+    return orders;
+}
+
+struct ReplayResult
+{
+    size_t accepted = 0;
+    size_t rejected = 0;
+    double seconds = 0.0;
+    std::vector<double> latencyUs; // sorted
+    std::vector<std::string> invariantFailures;
+};
+
+// Feed 'orders' to the engine from 'threads' threads, 'batch' orders per commit. The engine
+// is single-writer, so threads serialize on one lock; measured latency includes that wait,
+// and every order in a batch is charged the whole batch's latency.
+ReplayResult replayOrders(Warehouse &warehouse, const std::vector<Order> &orders, size_t threads, size_t batch = 1)
+{
+    ReplayResult result;
+    long long stockBefore = warehouse.totalStock();
+    size_t historyBefore = warehouse.getOrders().size();
+    std::vector<char> accepted(orders.size(), 0);
+    std::vector<double> latency(orders.size());
+    std::mutex engine;
+    std::atomic<size_t> next{0};
+    batch = std::max<size_t>(batch, 1);
+
+    auto worker = [&]
+    {
+        for (size_t i = next.fetch_add(batch); i < orders.size(); i = next.fetch_add(batch))
+        {
+            size_t end = std::min(i + batch, orders.size());
+            auto start = std::chrono::steady_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(engine);
+                if (batch == 1)
+                {
+                    accepted[i] = warehouse.tryProcessOrder(orders[i]);
+                }
+                else
+                {
+                    std::vector<char> committed = warehouse.processOrders(orders.data() + i, orders.data() + end);
+                    std::copy(committed.begin(), committed.end(), accepted.begin() + i);
+                }
+            }
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            std::fill(latency.begin() + i, latency.begin() + end, us);
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.latencyUs = std::move(latency);
+    std::sort(result.latencyUs.begin(), result.latencyUs.end());
+
+    // Invariants: stock is conserved and the order history matches what was accepted
+    long long consumed = 0;
+    std::map<int, int> acceptedPerMember;
+    std::vector<int> acceptedIds;
+    for (size_t i = 0; i < orders.size(); ++i)
+    {
+        if (!accepted[i])
+            continue;
+        ++result.accepted;
+        ++acceptedPerMember[orders[i].getMemberId()];
+        acceptedIds.push_back(orders[i].getId());
+        for (const auto &item : orders[i].getItems())
+            consumed += item.getQuantity();
+    }
+    result.rejected = orders.size() - result.accepted;
+    long long stockAfter = warehouse.totalStock();
+    if (stockBefore - consumed != stockAfter)
+        result.invariantFailures.push_back("stock not conserved: " + std::to_string(stockBefore) + " - " + std::to_string(consumed) +
+                                           " != " + std::to_string(stockAfter));
+    for (const auto &product : warehouse.getAllProducts())
+        if (product.getStock() < 0)
+            result.invariantFailures.push_back("negative stock for product " + std::to_string(product.getId()));
+    const auto &history = warehouse.getOrders();
+    std::vector<int> historyIds;
+    std::map<int, int> historyPerMember;
+    for (size_t i = historyBefore; i < history.size(); ++i)
+    {
+        historyIds.push_back(history[i].getId());
+        ++historyPerMember[history[i].getMemberId()];
+    }
+    std::sort(acceptedIds.begin(), acceptedIds.end());
+    std::sort(historyIds.begin(), historyIds.end());
+    if (acceptedIds != historyIds)
+        result.invariantFailures.push_back("order history (" + std::to_string(historyIds.size()) + " orders) does not match " +
+                                           std::to_string(acceptedIds.size()) + " accepted orders");
+    if (acceptedPerMember != historyPerMember)
+        result.invariantFailures.push_back("per-member order counts do not match the order history");
+    return result;
+}
+
+// FNV-1a over the generated stream, printed so two runs can be compared at a glance
+uint64_t orderStreamChecksum(const std::vector<Order> &orders)
+{
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](int value)
+    {
+        for (int byte = 0; byte < 4; ++byte)
+        {
+            hash ^= static_cast<unsigned char>(value >> (8 * byte));
+            hash *= 1099511628211ULL;
+        }
+    };
+    for (const auto &order : orders)
+    {
+        mix(order.getId());
+        mix(order.getMemberId());
+        for (const auto &item : order.getItems())
+        {
+            mix(item.getProductId());
+            mix(item.getQuantity());
+        }
+    }
+    return hash;
+}
+
+// Parse key=value overrides such as "seed=7 orders=500000 skew=1.2 threads=4"
+bool parseLoadProfile(int argc, char *argv[], int first, LoadProfile &profile)
+{
+    for (int i = first; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos)
+            return false;
+        std::string key = arg.substr(0, eq), value = arg.substr(eq + 1);
+        try
+        {
+            if (key == "seed")
+                profile.seed = std::stoull(value);
+            else if (key == "orders")
+                profile.orders = std::stoul(value);
+            else if (key == "products")
+                profile.products = std::stoi(value);
+            else if (key == "members")
+                profile.members = std::stoi(value);
+            else if (key == "skew")
+                profile.skew = std::stod(value);
+            else if (key == "min-items")
+                profile.minItems = std::stoi(value);
+            else if (key == "max-items")
+                profile.maxItems = std::stoi(value);
+            else if (key == "max-qty")
+                profile.maxQuantity = std::stoi(value);
+            else if (key == "employees")
+                profile.employeeShare = std::stod(value);
+            else if (key == "stockout")
+                profile.stockOutRate = std::stod(value);
+            else if (key == "stock")
+                profile.initialStock = std::stoi(value);
+            else if (key == "threads")
+                profile.threads = std::stoul(value);
+            else if (key == "batch")
+                profile.batch = std::stoul(value);
+            else
+                return false;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+    return profile.products > 0 && profile.members > 1 && profile.minItems > 0 && profile.maxItems >= profile.minItems &&
+           profile.maxQuantity > 0 && profile.threads > 0 && profile.batch > 0 &&
+           profile.employeeShare >= 0.0 && profile.employeeShare <= 1.0 &&
+           profile.stockOutRate >= 0.0 && profile.stockOutRate <= 1.0 && profile.initialStock >= 0;
+}
+
+void runSimulation(const LoadProfile &profile)
+{
+    Warehouse warehouse;
+    seedSimulationWarehouse(warehouse, profile);
+    std::vector<Order> orders = generateOrders(profile);
+    ReplayResult result = replayOrders(warehouse, orders, profile.threads, profile.batch);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "Seed " << profile.seed << ", stream checksum " << std::hex << orderStreamChecksum(orders) << std::dec << "\n"
+              << "Orders: " << orders.size() << " on " << profile.threads << " thread(s), batch " << profile.batch
+              << ", in " << result.seconds << "s, "
+              << static_cast<long long>(orders.size() / std::max(result.seconds, 1e-9)) << " orders/s\n"
+              << "Accepted " << result.accepted << ", rejected " << result.rejected << " ("
+              << 100.0 * result.rejected / std::max<size_t>(1, orders.size()) << "%)\n"
+              << "Latency us: p50 " << percentile(result.latencyUs, 0.50) << ", p90 " << percentile(result.latencyUs, 0.90)
+              << ", p99 " << percentile(result.latencyUs, 0.99) << ", p99.9 " << percentile(result.latencyUs, 0.999)
+              << ", max " << (result.latencyUs.empty() ? 0.0 : result.latencyUs.back()) << "\n"
+              << "Final stock " << warehouse.totalStock() << "\n"
+              << std::defaultfloat;
+    if (result.invariantFailures.empty())
+        std::cout << "Invariants: OK\n";
+    for (const auto &failure : result.invariantFailures)
+        std::cout << "Invariant FAILED: " << failure << "\n";
+}
+
+// Place many checkout holds on a virtual clock, settle some, and let the rest expire
+void benchHolds(size_t count)
+{
+    const int productCount = 10000;
+    Inventory inventory;
+    std::vector<Product> products;
+    for (int id = 1; id <= productCount; ++id)
+        products.emplace_back(id, "SKU " + std::to_string(id), 1000000, 1.0, 1);
+    inventory.addProducts(products);
+    ReservationBook book(inventory);
+    SimulationRandom rng(1);
+
+    const uint64_t start = 1000000;
+    auto timeIt = [](auto fn)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+    std::vector<uint64_t> holdIds;
+    holdIds.reserve(count);
+    double reserveSeconds = timeIt([&]
+                                   {
+        for (size_t i = 0; i < count; ++i)
+        {
+            Order order(static_cast<int>(i), 1);
+            order.addItem(OrderItem(rng.between(1, productCount), 1));
+            holdIds.push_back(book.reserve(order, rng.between(60, 30 * 60), start));
+        } });
+    size_t settled = 0;
+    double settleSeconds = timeIt([&]
+                                  {
+        for (size_t i = 0; i < count; i += 10)
+            settled += i % 20 == 0 ? book.confirm(holdIds[i], start, nullptr) : book.release(holdIds[i]);
+    });
+    size_t outstanding = book.activeHolds(), expired = 0;
+    double expireSeconds = timeIt([&]
+                                  {
+        for (uint64_t t = start; t <= start + 30 * 60; t += 15)
+            expired += book.expire(t); });
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Reserved " << count << " holds: " << reserveSeconds * 1e9 / std::max<size_t>(count, 1) << " ns each\n"
+              << "Confirmed/released " << settled << ": " << settleSeconds * 1e9 / std::max<size_t>(settled, 1) << " ns each\n"
+              << "Expired " << expired << " of " << outstanding << " outstanding: "
+              << expireSeconds * 1e9 / std::max<size_t>(expired, 1) << " ns each\n"
+              << std::defaultfloat;
+    if (book.activeHolds() != 0 || book.reservedStock(1) != 0)
+        std::cout << "Holds left after expiry: " << book.activeHolds() << "\n";
+}
+
+// Compare the generated Product codecs against the original hand-written TSV code
+void benchCodecs(size_t count)
+{
+    std::vector<Product> products;
+    products.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        products.emplace_back(static_cast<int>(i), "Product " + std::to_string(i), static_cast<int>(i % 500), (i % 10000) / 100.0, static_cast<int>(i % 50));
+
+    auto timeIt = [count](const char *label, auto fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::left << std::setw(28) << label << std::right << std::setw(12)
+                  << static_cast<long long>(count / std::max(seconds, 1e-9)) << " records/s\n";
+    };
+
+    std::ostringstream handText, codecText;
+    timeIt("TSV write (hand-written)", [&]
+           { for (const auto &p : products)
+                 handText << p.getId() << '\t' << p.getName() << '\t' << p.getStock() << '\t' << p.getPrice() << '\t' << p.getSupplierId() << '\n'; });
+    timeIt("TSV write (generated)", [&]
+           { for (const auto &p : products)
+                 RecordCodec<Product>::writeText(codecText, p); });
+
+    std::string text = codecText.str();
+    size_t handRead = 0, codecRead = 0;
+    timeIt("TSV read (hand-written)", [&]
+           {
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::istringstream iss(line);
+            int id, stock, supplierId;
+            double price;
+            std::string name;
+            if (iss >> id && iss.get() == '\t' && std::getline(iss, name, '\t') && iss >> stock && iss.get() == '\t' && iss >> price && iss.get() == '\t' && iss >> supplierId)
+                handRead += Product(id, name, stock, price, supplierId).getId() >= 0;
+        } });
+    timeIt("TSV read (generated)", [&]
+           {
+        const char *p = text.data(), *end = text.data() + text.size();
+        std::string error;
+        Product product;
+        while (p < end)
+        {
+            const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            if (!eol)
+                eol = end;
+            codecRead += RecordCodec<Product>::readRow(p, eol, '\t', product, error);
+            p = eol + 1;
+        } });
+
+    std::string binary;
+    size_t binaryRead = 0;
+    timeIt("binary encode (generated)", [&]
+           { for (const auto &p : products)
+                 RecordCodec<Product>::writeBinary(binary, p); });
+    timeIt("binary decode (generated)", [&]
+           {
+        const char *p = binary.data(), *end = binary.data() + binary.size();
+        Product product;
+        while (p < end && RecordCodec<Product>::readBinary(p, end, product, RecordCodec<Product>::version))
+            ++binaryRead; });
+
+    if (handRead != count || codecRead != count || binaryRead != count)
+        std::cout << "Round-trip mismatch: " << handRead << '/' << codecRead << '/' << binaryRead << " of " << count << "\n";
+}
+
+// Optional positive COUNT after a command; 'fallback' when it is omitted
+bool parseCountArg(int argc, char *argv[], size_t fallback, size_t &count)
+{
+    if (argc == 2)
+    {
+        count = fallback;
+        return true;
+    }
+    if (argc != 3)
+        return false;
+    const char *end = argv[2] + std::strlen(argv[2]);
+    auto result = std::from_chars(argv[2], end, count);
+    return result.ec == std::errc() && result.ptr == end && count > 0;
+}
+
+// Non-interactive commands: returns true if one was handled
+// 'exitCode' is set for commands that report success or failure
+bool runCommandLine(Warehouse &warehouse, int argc, char *argv[], int &exitCode)
+{
+    if (argc < 2)
+        return false;
+    std::string command = argv[1];
+    size_t count;
+    if ((command == "--import-products" || command == "--import-stock") && argc == 3)
+    {
+        ImportKind kind = command == "--import-products" ? ImportKind::Products : ImportKind::StockAdjustments;
+        ImportReport report = warehouse.importFile(argv[2], kind);
+        printImportReport(argv[2], report);
+        warehouse.saveData();
+        return true;
+    }
+    if (command == "--save-snapshot" && argc == 3)
+    {
+        if (!warehouse.saveSnapshot(argv[2]))
+            std::cout << "Could not write snapshot '" << argv[2] << "'.\n";
+        return true;
+    }
+    if (command == "--load-snapshot" && argc == 3)
+    {
+        if (warehouse.loadSnapshot(argv[2]))
+            warehouse.saveData();
+        else
+            std::cout << "Could not read snapshot '" << argv[2] << "'.\n";
+        return true;
+    }
+    if (command == "--bench-codecs" && parseCountArg(argc, argv, 1000000, count))
+    {
+        benchCodecs(count);
+        return true;
+    }
+    if (command == "--simulate")
+    {
+        LoadProfile profile;
+        if (parseLoadProfile(argc, argv, 2, profile))
+            runSimulation(profile);
+        else
+            std::cout << "Usage: " << argv[0] << " --simulate [seed=N] [orders=N] [products=N] [members=N] [skew=X]\n"
+                      << "        [min-items=N] [max-items=N] [max-qty=N] [employees=X] [stockout=X] [stock=N]\n"
+                      << "        [threads=N] [batch=N]\n";
+        return true;
+    }
+    if (command == "--bench-holds" && parseCountArg(argc, argv, 1000000, count))
+    {
+        benchHolds(count);
+        return true;
+    }
+    if (command == "--self-test" && argc == 2)
+    {
+        std::cout << "Password hashing known-answer tests:\n";
+        exitCode = selfTestCrypto() ? 0 : 1;
+        return true;
+    }
+    if (command == "--bench-auth" && parseCountArg(argc, argv, 64, count))
+    {
+        std::cout << "Password hashing known-answer tests:\n";
+        if (!selfTestCrypto())
+        {
+            std::cout << "Password hashing is broken; not benchmarking it.\n";
+            exitCode = 1;
+            return true;
+        }
+        benchAuth(count);
+        return true;
+    }
+    std::cout << "Usage: " << argv[0] << " [--trace PREFIX] [--import-products FILE | --import-stock FILE |\n"
+              << "        --save-snapshot FILE | --load-snapshot FILE |\n"
+              << "        --bench-codecs [COUNT] | --bench-auth [LOGINS] | --bench-holds [COUNT] |\n"
+              << "        --simulate [KEY=VALUE...] | --self-test]\n";
+    return true;
 }
 
 // Main function (entry point)
-int main()
+int main(int argc, char *argv[])
 {
+    // --trace PREFIX must come first; the remaining arguments are handled as usual
+    std::string tracePrefix = "sip_trace";
+    bool traceFromStart = argc >= 3 && std::string(argv[1]) == "--trace";
+    if (traceFromStart)
+    {
+        tracePrefix = argv[2];
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+#ifdef SIP_PROFILE
+    TraceOnExit traceOnExit(tracePrefix);
+    Profiler::installSignalTrigger(tracePrefix);
+    if (traceFromStart)
+        Profiler::start();
+#else
+    if (traceFromStart)
+        std::cout << "Tracing is not available: rebuild with -DSIP_PROFILE (make profile).\n";
+#endif
     Warehouse warehouse;
-    warehouse.loadData(); // Load data at startup
+    if (!warehouse.loadData()) // Load data at startup
+    {
+        std::cout << "Data files were written by a newer version of SmartInventoryPro. Exiting without changes.\n";
+        return 1;
+    }
+    int exitCode = 0;
+    if (runCommandLine(warehouse, argc, argv, exitCode))
+        return exitCode;
     int choice;
     while (true)
     {
@@ -811,12 +3199,15 @@ int main()
             warehouse.showMemberOrderCounts();
             break;
         case 12:
+            bulkImportUI(warehouse);
+            break;
+        case 13:
             warehouse.saveData(); // Save data on exit
             std::cout << "Goodbye!\n";
             return 0;
         default:
             std::cout << "Invalid option!\n";
-            pause();
+            pauseScreen();
             break;
         }
     }